@@ -81,6 +81,29 @@ function(qsk_add_plugin target TYPE CLASS_NAME)
 
 endfunction()
 
+function(qsk_add_snapshot_version target)
+
+    # A hash of the sources, that set up the hints of a skin. It ends up
+    # in the key of the files written by QskSkinSnapshot, so that snapshots
+    # of a different implementation of the skin are not restored.
+    # Modifying one of the sources triggers a reconfiguration.
+
+    set(hashes "")
+
+    foreach(source IN LISTS ARGN)
+        get_filename_component(path "${source}" ABSOLUTE)
+
+        file(SHA1 "${path}" hash)
+        string(APPEND hashes "${hash}")
+
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${path}")
+    endforeach()
+
+    string(SHA1 version "${hashes}")
+    target_compile_definitions(${target} PRIVATE QSK_SNAPSHOT_VERSION="${version}")
+
+endfunction()
+
 function(qsk_add_example target)
 
     cmake_parse_arguments(PARSE_ARGV 1 arg "MANUAL_FINALIZATION" "" "")
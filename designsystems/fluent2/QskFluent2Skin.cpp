@@ -62,6 +62,7 @@
 #include <QskListView.h>
 #include <QskMenu.h>
 #include <QskPageIndicator.h>
+#include <QskPopup.h>
 #include <QskPushButton.h>
 #include <QskProgressBar.h>
 #include <QskProgressRing.h>
@@ -102,6 +103,8 @@
 #include <qguiapplication.h>
 #include <qfontinfo.h>
 
+#include <memory>
+
 static void qskFluent2InitResources()
 {
     Q_INIT_RESOURCE( QskFluent2Icons );
@@ -221,9 +224,7 @@ namespace
         }
 
         void setupMetrics();
-        void setupColors( QskAspect::Section, const QskFluent2Theme& );
 
-      private:
         void setupPopup( const QskFluent2Theme& );
         void setupSubWindow( const QskFluent2Theme& );
         void setupDialogSubWindow( const QskFluent2Theme& );
@@ -306,6 +307,7 @@ namespace
         void setupVirtualKeyboardMetrics();
         void setupVirtualKeyboardColors( QskAspect::Section, const QskFluent2Theme& );
 
+      private:
         inline QskGraphic symbol( const char* name ) const
         {
             const QString path = QStringLiteral( ":fluent2/icons/qvg/" )
@@ -329,6 +331,18 @@ namespace
             setBoxBorderGradient( aspect, gradient[ 0 ], gradient[ 1 ], baseColor );
         }
     };
+
+    class Themes
+    {
+      public:
+        inline const QskFluent2Theme& theme( QskAspect::Section section ) const
+        {
+            return ( section == QskAspect::Body ) ? body : header;
+        }
+
+        const QskFluent2Theme body;
+        const QskFluent2Theme header; // also used for the footer
+    };
 }
 
 void Editor::setupMetrics()
@@ -361,45 +375,6 @@ void Editor::setupMetrics()
     setupVirtualKeyboardMetrics();
 }
 
-void Editor::setupColors( QskAspect::Section section, const QskFluent2Theme& theme )
-{
-    if ( section == QskAspect::Body )
-    {
-        // TODO
-        setupPopup( theme );
-        setupSubWindow( theme );
-        setupDialogSubWindow( theme );
-    }
-
-    setupBoxColors( section, theme );
-    setupCheckBoxColors( section, theme );
-    setupComboBoxColors( section, theme );
-    setupDialogButtonBoxColors( section, theme );
-    setupDrawerColors( section, theme );
-    setupFocusIndicatorColors( section, theme );
-    setupGraphicLabelColors( section, theme );
-    setupGraphicLabelMetrics();
-    setupListViewColors( section, theme );
-    setupMenuColors( section, theme );
-    setupPageIndicatorColors( section, theme );
-    setupProgressBarColors( section, theme );
-    setupProgressRingColors( section, theme );
-    setupPushButtonColors( section, theme );
-    setupRadioBoxColors( section, theme );
-    setupScrollViewColors( section, theme );
-    setupSegmentedBarColors( section, theme );
-    setupSeparatorColors( section, theme );
-    setupSliderColors( section, theme );
-    setupSwitchButtonColors( section, theme );
-    setupSpinBoxColors( section, theme );
-    setupTabButtonColors( section, theme );
-    setupTabBarColors( section, theme );
-    setupTabViewColors( section, theme );
-    setupTextFieldColors( section, theme );
-    setupTextLabelColors( section, theme );
-    setupVirtualKeyboardColors( section, theme );
-};
-
 void Editor::setupBoxMetrics()
 {
 }
@@ -2041,20 +2016,14 @@ QskFluent2Skin::QskFluent2Skin( QObject* parent )
     editor.setupMetrics();
 }
 
-void QskFluent2Skin::addTheme( QskAspect::Section section, const QskFluent2Theme& theme )
+QskFluent2Skin::~QskFluent2Skin()
 {
-    if ( section == QskAspect::Body )
-    {
-        // design flaw: we can't have section sensitive filters. TODO ..
-        setupGraphicFilters( theme );
-    }
-
-    Editor editor( &hintTable() );
-    editor.setupColors( section, theme );
 }
 
-QskFluent2Skin::~QskFluent2Skin()
+QByteArray QskFluent2Skin::snapshotVersion() const
 {
+    // see qsk_add_snapshot_version
+    return QByteArrayLiteral( QSK_SNAPSHOT_VERSION );
 }
 
 void QskFluent2Skin::initHints()
@@ -2084,18 +2053,109 @@ void QskFluent2Skin::initHints()
 
     setupFonts();
 
-    Editor editor( &hintTable() );
-    editor.setupMetrics();
-
     const QskFluent2Theme themeBody( colorScheme(),
         colors[0].baseColors, colors[0].accentColors );
 
     const QskFluent2Theme themeHeader( colorScheme(),
         colors[1].baseColors, colors[1].accentColors );
 
-    addTheme( QskAspect::Body, themeBody );
-    addTheme( QskAspect::Header, themeHeader );
-    addTheme( QskAspect::Footer, themeHeader );
+    // design flaw: we can't have section sensitive filters. TODO ..
+    setupGraphicFilters( themeBody );
+
+    /*
+        The hints of a control class are not populated before
+        the class is in use for the first time.
+     */
+    const auto themes = std::make_shared< const Themes >(
+        Themes { themeBody, themeHeader } );
+
+    const auto declare = [ this, themes ]( const QMetaObject& metaObject,
+        void ( Editor::*metrics )(),
+        void ( Editor::*colors )( QskAspect::Section, const QskFluent2Theme& ),
+        const QVector< QskAspect::Subcontrol >& inheritedSubcontrols = {} )
+    {
+        declareHints( &metaObject,
+            [ themes, metrics, colors ]( QskSkinHintTable* table )
+            {
+                Editor editor( table );
+                ( editor.*metrics )();
+
+                for ( const auto section :
+                    { QskAspect::Body, QskAspect::Header, QskAspect::Footer } )
+                {
+                    ( editor.*colors )( section, themes->theme( section ) );
+                }
+            }, inheritedSubcontrols );
+    };
+
+    const auto declareBody = [ this, themes ]( const QMetaObject& metaObject,
+        void ( Editor::*colors )( const QskFluent2Theme& ) )
+    {
+        declareHints( &metaObject,
+            [ themes, colors ]( QskSkinHintTable* table )
+            {
+                Editor editor( table );
+                ( editor.*colors )( themes->body );
+            } );
+    };
+
+    declareBody( QskPopup::staticMetaObject, &Editor::setupPopup );
+    declareBody( QskSubWindow::staticMetaObject, &Editor::setupSubWindow );
+    declareBody( QskDialogSubWindow::staticMetaObject, &Editor::setupDialogSubWindow );
+
+    declare( QskBox::staticMetaObject,
+        &Editor::setupBoxMetrics, &Editor::setupBoxColors );
+    declare( QskCheckBox::staticMetaObject,
+        &Editor::setupCheckBoxMetrics, &Editor::setupCheckBoxColors );
+    declare( QskComboBox::staticMetaObject,
+        &Editor::setupComboBoxMetrics, &Editor::setupComboBoxColors );
+    declare( QskDialogButtonBox::staticMetaObject,
+        &Editor::setupDialogButtonBoxMetrics, &Editor::setupDialogButtonBoxColors );
+    declare( QskDrawer::staticMetaObject,
+        &Editor::setupDrawerMetrics, &Editor::setupDrawerColors );
+    declare( QskFocusIndicator::staticMetaObject,
+        &Editor::setupFocusIndicatorMetrics, &Editor::setupFocusIndicatorColors );
+    declare( QskGraphicLabel::staticMetaObject,
+        &Editor::setupGraphicLabelMetrics, &Editor::setupGraphicLabelColors );
+    declare( QskListView::staticMetaObject,
+        &Editor::setupListViewMetrics, &Editor::setupListViewColors );
+    declare( QskMenu::staticMetaObject,
+        &Editor::setupMenuMetrics, &Editor::setupMenuColors );
+    declare( QskPageIndicator::staticMetaObject,
+        &Editor::setupPageIndicatorMetrics, &Editor::setupPageIndicatorColors );
+    declare( QskProgressBar::staticMetaObject,
+        &Editor::setupProgressBarMetrics, &Editor::setupProgressBarColors );
+    declare( QskProgressRing::staticMetaObject,
+        &Editor::setupProgressRingMetrics, &Editor::setupProgressRingColors );
+    declare( QskPushButton::staticMetaObject,
+        &Editor::setupPushButtonMetrics, &Editor::setupPushButtonColors );
+    declare( QskRadioBox::staticMetaObject,
+        &Editor::setupRadioBoxMetrics, &Editor::setupRadioBoxColors );
+    declare( QskScrollView::staticMetaObject,
+        &Editor::setupScrollViewMetrics, &Editor::setupScrollViewColors );
+    declare( QskSegmentedBar::staticMetaObject,
+        &Editor::setupSegmentedBarMetrics, &Editor::setupSegmentedBarColors );
+    declare( QskSeparator::staticMetaObject,
+        &Editor::setupSeparatorMetrics, &Editor::setupSeparatorColors );
+    declare( QskSlider::staticMetaObject,
+        &Editor::setupSliderMetrics, &Editor::setupSliderColors );
+    declare( QskSwitchButton::staticMetaObject,
+        &Editor::setupSwitchButtonMetrics, &Editor::setupSwitchButtonColors );
+    declare( QskSpinBox::staticMetaObject,
+        &Editor::setupSpinBoxMetrics, &Editor::setupSpinBoxColors );
+    declare( QskTabButton::staticMetaObject,
+        &Editor::setupTabButtonMetrics, &Editor::setupTabButtonColors );
+    declare( QskTabBar::staticMetaObject,
+        &Editor::setupTabBarMetrics, &Editor::setupTabBarColors );
+    declare( QskTabView::staticMetaObject,
+        &Editor::setupTabViewMetrics, &Editor::setupTabViewColors );
+    declare( QskTextField::staticMetaObject,
+        &Editor::setupTextFieldMetrics, &Editor::setupTextFieldColors,
+        { QskTextInput::TextPanel, QskTextInput::Text } );
+    declare( QskTextLabel::staticMetaObject,
+        &Editor::setupTextLabelMetrics, &Editor::setupTextLabelColors );
+    declare( QskVirtualKeyboard::staticMetaObject,
+        &Editor::setupVirtualKeyboardMetrics, &Editor::setupVirtualKeyboardColors );
 }
 
 static inline QFont createFont( qreal size, int lineHeight, QFont::Weight weight )
@@ -21,6 +21,8 @@ class QSK_FLUENT2_EXPORT QskFluent2Skin : public QskSkin
     QskFluent2Skin( QObject* parent = nullptr );
     ~QskFluent2Skin() override;
 
+    QByteArray snapshotVersion() const override;
+
     enum GraphicRole
     {
         GraphicRoleFillColorTextDisabled,
@@ -38,8 +40,6 @@ class QSK_FLUENT2_EXPORT QskFluent2Skin : public QskSkin
     void initHints() override;
 
   private:
-    void addTheme( QskAspect::Section, const QskFluent2Theme& );
-
     void setupFonts();
     void setupGraphicFilters( const QskFluent2Theme& );
     void setGraphicColor( GraphicRole, QRgb );
@@ -63,6 +63,8 @@
 #include <qpainter.h>
 #include <qpainterpath.h>
 
+#include <memory>
+
 static const int qskDuration = 50;
 
 /*
@@ -98,8 +100,6 @@ namespace
 
     class Editor : private QskSkinHintTableEditor
     {
-        Q_GADGET
-
       public:
         Editor( const QskFusionPalette& palette, QskSkinHintTable* table )
             : QskSkinHintTableEditor( table )
@@ -107,44 +107,38 @@ namespace
         {
         }
 
-        void setup()
-        {
-            for ( int i = 0; i < staticMetaObject.methodCount(); i++ )
-                staticMetaObject.method( i ).invokeOnGadget( this );
-        }
+        void setupBox();
+        void setupCheckBox();
+        void setupComboBox();
+        void setupDialogButtonBox();
+        void setupDialogSubWindow();
+        void setupDrawer();
+        void setupFocusIndicator();
+        void setupGraphicLabel();
+        void setupInputPanel();
+        void setupVirtualKeyboard();
+        void setupListView();
+        void setupMenu();
+        void setupPageIndicator();
+        void setupPopup();
+        void setupProgressBar();
+        void setupProgressRing();
+        void setupRadioBox();
+        void setupPushButton();
+        void setupScrollView();
+        void setupSegmentedBar();
+        void setupSeparator();
+        void setupSubWindow();
+        void setupSlider();
+        void setupSpinBox();
+        void setupSwitchButton();
+        void setupTabButton();
+        void setupTabBar();
+        void setupTabView();
+        void setupTextField();
+        void setupTextLabel();
 
       private:
-        Q_INVOKABLE void setupBox();
-        Q_INVOKABLE void setupCheckBox();
-        Q_INVOKABLE void setupComboBox();
-        Q_INVOKABLE void setupDialogButtonBox();
-        Q_INVOKABLE void setupDialogSubWindow();
-        Q_INVOKABLE void setupDrawer();
-        Q_INVOKABLE void setupFocusIndicator();
-        Q_INVOKABLE void setupGraphicLabel();
-        Q_INVOKABLE void setupInputPanel();
-        Q_INVOKABLE void setupVirtualKeyboard();
-        Q_INVOKABLE void setupListView();
-        Q_INVOKABLE void setupMenu();
-        Q_INVOKABLE void setupPageIndicator();
-        Q_INVOKABLE void setupPopup();
-        Q_INVOKABLE void setupProgressBar();
-        Q_INVOKABLE void setupProgressRing();
-        Q_INVOKABLE void setupRadioBox();
-        Q_INVOKABLE void setupPushButton();
-        Q_INVOKABLE void setupScrollView();
-        Q_INVOKABLE void setupSegmentedBar();
-        Q_INVOKABLE void setupSeparator();
-        Q_INVOKABLE void setupSubWindow();
-        Q_INVOKABLE void setupSlider();
-        Q_INVOKABLE void setupSpinBox();
-        Q_INVOKABLE void setupSwitchButton();
-        Q_INVOKABLE void setupTabButton();
-        Q_INVOKABLE void setupTabBar();
-        Q_INVOKABLE void setupTabView();
-        Q_INVOKABLE void setupTextField();
-        Q_INVOKABLE void setupTextLabel();
-
         QskGraphic symbol( const char* name ) const
         {
             QskGraphic graphic;
@@ -1365,6 +1359,12 @@ QskFusionSkin::~QskFusionSkin()
 {
 }
 
+QByteArray QskFusionSkin::snapshotVersion() const
+{
+    // see qsk_add_snapshot_version
+    return QByteArrayLiteral( QSK_SNAPSHOT_VERSION );
+}
+
 void QskFusionSkin::initHints()
 {
     clearHints();
@@ -1391,8 +1391,55 @@ void QskFusionSkin::initHints()
         setGraphicColor( GraphicIndicator, rgb );
     }
 
-    Editor editor( palette, &hintTable() );
-    editor.setup();
+    /*
+        The hints of a control class are not populated before
+        the class is in use for the first time.
+     */
+    const auto sharedPalette = std::make_shared< const QskFusionPalette >( palette );
+
+    const auto declare = [ this, sharedPalette ](
+        const QMetaObject& metaObject, void ( Editor::*setup )(),
+        const QVector< QskAspect::Subcontrol >& inheritedSubcontrols = {} )
+    {
+        declareHints( &metaObject,
+            [ sharedPalette, setup ]( QskSkinHintTable* table )
+            {
+                Editor editor( *sharedPalette, table );
+                ( editor.*setup )();
+            }, inheritedSubcontrols );
+    };
+
+    declare( QskBox::staticMetaObject, &Editor::setupBox );
+    declare( QskCheckBox::staticMetaObject, &Editor::setupCheckBox );
+    declare( QskComboBox::staticMetaObject, &Editor::setupComboBox );
+    declare( QskDialogButtonBox::staticMetaObject, &Editor::setupDialogButtonBox );
+    declare( QskDialogSubWindow::staticMetaObject, &Editor::setupDialogSubWindow );
+    declare( QskDrawer::staticMetaObject, &Editor::setupDrawer );
+    declare( QskFocusIndicator::staticMetaObject, &Editor::setupFocusIndicator );
+    declare( QskGraphicLabel::staticMetaObject, &Editor::setupGraphicLabel );
+    declare( QskInputPanelBox::staticMetaObject, &Editor::setupInputPanel );
+    declare( QskVirtualKeyboard::staticMetaObject, &Editor::setupVirtualKeyboard );
+    declare( QskListView::staticMetaObject, &Editor::setupListView );
+    declare( QskMenu::staticMetaObject, &Editor::setupMenu, { QskPopup::Overlay } );
+    declare( QskPageIndicator::staticMetaObject, &Editor::setupPageIndicator );
+    declare( QskPopup::staticMetaObject, &Editor::setupPopup );
+    declare( QskProgressBar::staticMetaObject, &Editor::setupProgressBar );
+    declare( QskProgressRing::staticMetaObject, &Editor::setupProgressRing );
+    declare( QskRadioBox::staticMetaObject, &Editor::setupRadioBox );
+    declare( QskPushButton::staticMetaObject, &Editor::setupPushButton );
+    declare( QskScrollView::staticMetaObject, &Editor::setupScrollView );
+    declare( QskSegmentedBar::staticMetaObject, &Editor::setupSegmentedBar );
+    declare( QskSeparator::staticMetaObject, &Editor::setupSeparator );
+    declare( QskSubWindow::staticMetaObject, &Editor::setupSubWindow );
+    declare( QskSlider::staticMetaObject, &Editor::setupSlider );
+    declare( QskSpinBox::staticMetaObject, &Editor::setupSpinBox );
+    declare( QskSwitchButton::staticMetaObject, &Editor::setupSwitchButton );
+    declare( QskTabButton::staticMetaObject, &Editor::setupTabButton );
+    declare( QskTabBar::staticMetaObject, &Editor::setupTabBar );
+    declare( QskTabView::staticMetaObject, &Editor::setupTabView );
+    declare( QskTextField::staticMetaObject, &Editor::setupTextField,
+        { QskTextInput::TextPanel, QskTextInput::Text } );
+    declare( QskTextLabel::staticMetaObject, &Editor::setupTextLabel );
 }
 
 void QskFusionSkin::setGraphicColor( GraphicRole role, QRgb rgb )
@@ -1405,4 +1452,3 @@ void QskFusionSkin::setGraphicColor( GraphicRole role, QRgb rgb )
 }
 
 #include "moc_QskFusionSkin.cpp"
-#include "QskFusionSkin.moc"
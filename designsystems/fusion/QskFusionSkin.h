@@ -19,6 +19,8 @@ class QSK_FUSION_EXPORT QskFusionSkin : public QskSkin
     QskFusionSkin( QObject* parent = nullptr );
     ~QskFusionSkin() override;
 
+    QByteArray snapshotVersion() const override;
+
     enum GraphicRole
     {
         GraphicNormal,
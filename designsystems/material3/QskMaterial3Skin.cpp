@@ -66,6 +66,8 @@
 #include <qguiapplication.h>
 #include <qfontinfo.h>
 
+#include <memory>
+
 static void qskMaterial3InitResources()
 {
     Q_INIT_RESOURCE( QskMaterial3Icons );
@@ -139,8 +141,6 @@ namespace
 
     class Editor : private QskSkinHintTableEditor
     {
-        Q_GADGET
-
       public:
         Editor( QskSkinHintTable* table, const QskMaterial3Theme& theme )
             : QskSkinHintTableEditor( table )
@@ -148,46 +148,43 @@ namespace
         {
         }
 
-        void setup()
+        void setupDefaults()
         {
             // default font
             setFontRole( QskAspect::NoSubcontrol, BodyLarge );
-
-            for ( int i = 0; i < staticMetaObject.methodCount(); i++ )
-                staticMetaObject.method( i ).invokeOnGadget( this );
         }
 
-      private:
-        Q_INVOKABLE void setupBox();
-        Q_INVOKABLE void setupCheckBox();
-        Q_INVOKABLE void setupComboBox();
-        Q_INVOKABLE void setupDialogButtonBox();
-        Q_INVOKABLE void setupDialogSubWindow();
-        Q_INVOKABLE void setupDrawer();
-        Q_INVOKABLE void setupFocusIndicator();
-        Q_INVOKABLE void setupInputPanel();
-        Q_INVOKABLE void setupVirtualKeyboard();
-        Q_INVOKABLE void setupListView();
-        Q_INVOKABLE void setupMenu();
-        Q_INVOKABLE void setupPageIndicator();
-        Q_INVOKABLE void setupPopup();
-        Q_INVOKABLE void setupProgressBar();
-        Q_INVOKABLE void setupProgressRing();
-        Q_INVOKABLE void setupRadioBox();
-        Q_INVOKABLE void setupPushButton();
-        Q_INVOKABLE void setupScrollView();
-        Q_INVOKABLE void setupSegmentedBar();
-        Q_INVOKABLE void setupSeparator();
-        Q_INVOKABLE void setupSubWindow();
-        Q_INVOKABLE void setupSlider();
-        Q_INVOKABLE void setupSpinBox();
-        Q_INVOKABLE void setupSwitchButton();
-        Q_INVOKABLE void setupTabButton();
-        Q_INVOKABLE void setupTabBar();
-        Q_INVOKABLE void setupTabView();
-        Q_INVOKABLE void setupTextField();
-        Q_INVOKABLE void setupTextLabel();
+        void setupBox();
+        void setupCheckBox();
+        void setupComboBox();
+        void setupDialogButtonBox();
+        void setupDialogSubWindow();
+        void setupDrawer();
+        void setupFocusIndicator();
+        void setupInputPanel();
+        void setupVirtualKeyboard();
+        void setupListView();
+        void setupMenu();
+        void setupPageIndicator();
+        void setupPopup();
+        void setupProgressBar();
+        void setupProgressRing();
+        void setupRadioBox();
+        void setupPushButton();
+        void setupScrollView();
+        void setupSegmentedBar();
+        void setupSeparator();
+        void setupSubWindow();
+        void setupSlider();
+        void setupSpinBox();
+        void setupSwitchButton();
+        void setupTabButton();
+        void setupTabBar();
+        void setupTabView();
+        void setupTextField();
+        void setupTextLabel();
 
+      private:
         QskGraphic symbol( const char* name ) const
         {
             const QString path = QStringLiteral( ":m3/icons/qvg/" )
@@ -1618,6 +1615,12 @@ QskMaterial3Skin::~QskMaterial3Skin()
 {
 }
 
+QByteArray QskMaterial3Skin::snapshotVersion() const
+{
+    // see qsk_add_snapshot_version
+    return QByteArrayLiteral( QSK_SNAPSHOT_VERSION );
+}
+
 static inline QFont createFont( qreal size, qreal lineHeight,
     qreal spacing, QFont::Weight weight )
 {
@@ -1712,8 +1715,56 @@ void QskMaterial3Skin::initHints()
     setupGraphicFilters( theme );
 
     Editor editor( &hintTable(), theme );
-    editor.setup();
+    editor.setupDefaults();
+
+    /*
+        The hints of a control class are not populated before
+        the class is in use for the first time.
+     */
+    const auto sharedTheme = std::make_shared< const QskMaterial3Theme >( theme );
+
+    const auto declare = [ this, sharedTheme ](
+        const QMetaObject& metaObject, void ( Editor::*setup )(),
+        const QVector< QskAspect::Subcontrol >& inheritedSubcontrols = {} )
+    {
+        declareHints( &metaObject,
+            [ sharedTheme, setup ]( QskSkinHintTable* table )
+            {
+                Editor editor( table, *sharedTheme );
+                ( editor.*setup )();
+            }, inheritedSubcontrols );
+    };
+
+    declare( QskBox::staticMetaObject, &Editor::setupBox );
+    declare( QskCheckBox::staticMetaObject, &Editor::setupCheckBox );
+    declare( QskComboBox::staticMetaObject, &Editor::setupComboBox );
+    declare( QskDialogButtonBox::staticMetaObject, &Editor::setupDialogButtonBox );
+    declare( QskDialogSubWindow::staticMetaObject, &Editor::setupDialogSubWindow );
+    declare( QskDrawer::staticMetaObject, &Editor::setupDrawer );
+    declare( QskFocusIndicator::staticMetaObject, &Editor::setupFocusIndicator );
+    declare( QskInputPanelBox::staticMetaObject, &Editor::setupInputPanel );
+    declare( QskVirtualKeyboard::staticMetaObject, &Editor::setupVirtualKeyboard );
+    declare( QskListView::staticMetaObject, &Editor::setupListView );
+    declare( QskMenu::staticMetaObject, &Editor::setupMenu, { QskPopup::Overlay } );
+    declare( QskPageIndicator::staticMetaObject, &Editor::setupPageIndicator );
+    declare( QskPopup::staticMetaObject, &Editor::setupPopup );
+    declare( QskProgressBar::staticMetaObject, &Editor::setupProgressBar );
+    declare( QskProgressRing::staticMetaObject, &Editor::setupProgressRing );
+    declare( QskRadioBox::staticMetaObject, &Editor::setupRadioBox );
+    declare( QskPushButton::staticMetaObject, &Editor::setupPushButton );
+    declare( QskScrollView::staticMetaObject, &Editor::setupScrollView );
+    declare( QskSegmentedBar::staticMetaObject, &Editor::setupSegmentedBar );
+    declare( QskSeparator::staticMetaObject, &Editor::setupSeparator );
+    declare( QskSubWindow::staticMetaObject, &Editor::setupSubWindow );
+    declare( QskSlider::staticMetaObject, &Editor::setupSlider );
+    declare( QskSpinBox::staticMetaObject, &Editor::setupSpinBox );
+    declare( QskSwitchButton::staticMetaObject, &Editor::setupSwitchButton );
+    declare( QskTabButton::staticMetaObject, &Editor::setupTabButton );
+    declare( QskTabBar::staticMetaObject, &Editor::setupTabBar );
+    declare( QskTabView::staticMetaObject, &Editor::setupTabView );
+    declare( QskTextField::staticMetaObject, &Editor::setupTextField,
+        { QskTextInput::TextPanel, QskTextInput::Text } );
+    declare( QskTextLabel::staticMetaObject, &Editor::setupTextLabel );
 }
 
 #include "moc_QskMaterial3Skin.cpp"
-#include "QskMaterial3Skin.moc"
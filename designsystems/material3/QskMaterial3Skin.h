@@ -135,6 +135,8 @@ class QSK_MATERIAL3_EXPORT QskMaterial3Skin : public QskSkin
     QskMaterial3Skin( QObject* parent = nullptr );
     ~QskMaterial3Skin() override;
 
+    QByteArray snapshotVersion() const override;
+
   protected:
     void initHints() override;
 
@@ -104,7 +104,7 @@ void Frame::updateNode( QSGNode* parentNode )
     const QRectF rect = contentsRect();
     if ( rect.isEmpty() )
     {
-        delete node;
+        QskSGNode::removeChildNode( parentNode, nodeRole );
         return;
     }
 
@@ -116,8 +116,7 @@ void Frame::updateNode( QSGNode* parentNode )
 
     updateFrameNode( rect, node );
 
-    if ( node->parent() != parentNode )
-        parentNode->appendChildNode( node );
+    QskSGNode::setParentNode( node, parentNode );
 }
 
 void Frame::updateFrameNode( const QRectF& rect, QskBoxRectangleNode* node )
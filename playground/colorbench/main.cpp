@@ -0,0 +1,131 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Micro benchmark for the batch operations of QskRgb, comparing
+    them with doing the same per value.
+ */
+
+#include <QskRgbValue.h>
+#include <QskGradientStop.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QVector>
+
+#include <algorithm>
+
+static const int qskTableSize = 1024;
+static const int qskLoops = 10000;
+
+static QskGradientStops stops()
+{
+    using namespace QskRgb;
+
+    return {
+        { 0.0, Crimson }, { 0.2, toTransparent( Gold, 100 ) },
+        { 0.5, SteelBlue }, { 0.7, toTransparent( Teal, 200 ) },
+        { 1.0, Ivory }
+    };
+}
+
+static void colorTablePerValue( int size, const QskGradientStops& stops, QRgb* values )
+{
+    /*
+        Similar to the implementation of QskRgb::colorTable before
+        using the batch operations - ignoring the byte order
+     */
+
+    int index1 = qRound( stops[0].position() * size );
+    QRgb rgb1 = qPremultiply( stops[0].rgb() );
+
+    for ( int i = 0; i < index1; i++ )
+        values[i] = rgb1;
+
+    for ( int i = 1; i < stops.count(); i++ )
+    {
+        const int index2 = qRound( stops[i].position() * size );
+        const QRgb rgb2 = qPremultiply( stops[i].rgb() );
+
+        const int n = index2 - index1;
+        for ( int j = 0; j < n; j++ )
+        {
+            const qreal ratio = ( n > 1 ) ? qreal( j ) / ( n - 1 ) : 0.0;
+            values[ index1 + j ] = QskRgb::interpolated( rgb1, rgb2, ratio );
+        }
+
+        index1 = index2;
+        rgb1 = rgb2;
+    }
+
+    for ( int i = index1; i < size; i++ )
+        values[i] = rgb1;
+}
+
+template< typename T >
+static void benchmark( const char* name, T function )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < qskLoops; i++ )
+        function();
+
+    qDebug().noquote() << name << ":"
+        << timer.nsecsElapsed() / qskLoops << "ns";
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    const auto gradientStops = stops();
+
+    QVector< QRgb > values( qskTableSize );
+    QVector< QRgb > rgbs( qskTableSize );
+
+    for ( int i = 0; i < rgbs.size(); i++ )
+        rgbs[i] = qRgba( i % 256, ( 3 * i ) % 256, ( 7 * i ) % 256, ( 11 * i ) % 256 );
+
+    benchmark( "colorTable, per value",
+        [&] { colorTablePerValue( qskTableSize, gradientStops, values.data() ); } );
+
+    benchmark( "colorTable, batch",
+        [&] { QskRgb::colorTable( qskTableSize, gradientStops, values.data() ); } );
+
+    benchmark( "interpolate, per value",
+        [&]
+        {
+            for ( int i = 0; i < qskTableSize; i++ )
+            {
+                values[i] = QskRgb::interpolated( QskRgb::Crimson,
+                    QskRgb::SteelBlue, qreal( i ) / ( qskTableSize - 1 ) );
+            }
+        } );
+
+    benchmark( "interpolate, batch",
+        [&]
+        {
+            QskRgb::interpolate( QskRgb::Crimson, QskRgb::SteelBlue,
+                values.data(), qskTableSize );
+        } );
+
+    benchmark( "premultiply, per value",
+        [&]
+        {
+            for ( int i = 0; i < qskTableSize; i++ )
+                values[i] = qPremultiply( rgbs[i] );
+        } );
+
+    benchmark( "premultiply, batch",
+        [&]
+        {
+            std::copy( rgbs.constBegin(), rgbs.constEnd(), values.begin() );
+            QskRgb::premultiply( values.data(), values.size() );
+        } );
+
+    return 0;
+}
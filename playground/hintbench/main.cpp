@@ -0,0 +1,134 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Micro benchmark for resolving skin hints, comparing the hash
+    of QskSkinHintTable with the lookup table of a frozen table.
+    The tables are those of the Material3, Fluent2 and Fusion skins
+    with all hints being populated.
+ */
+
+#include <QskAspect.h>
+#include <QskSkin.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinManager.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QSet>
+#include <QVector>
+
+static const int qskLoops = 100;
+
+static QskSkinHintTable hashTable( const QskSkinHintTable& table )
+{
+    // building a table from scratch, that has never been frozen
+
+    QskSkinHintTable hashTable;
+
+    const auto hints = table.hints();
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        hashTable.setHint( it.key(), it.value() );
+
+    return hashTable;
+}
+
+static QVector< QskAspect > aspects( const QskSkinHintTable& table )
+{
+    /*
+        The fully expanded aspects, as being resolved by the controls:
+        the aspects of the table with and without the states, that are
+        in use. Most of them need a couple of probes for dropping the states.
+     */
+
+    QVector< QskAspect::State > states;
+
+    for ( uint i = 0; i < 16; i++ )
+    {
+        const auto state = static_cast< QskAspect::State >( 1 << i );
+        if ( table.states() & state )
+            states += state;
+    }
+
+    QSet< QskAspect > aspects;
+
+    const auto hints = table.hints();
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+    {
+        const auto aspect = it.key().stateless();
+        if ( aspect.isAnimator() )
+            continue;
+
+        aspects += aspect;
+
+        for ( int i = 0; i < states.size(); i++ )
+        {
+            aspects += aspect | states[ i ];
+
+            if ( i > 0 )
+                aspects += aspect | states[ i ] | states[ i - 1 ];
+        }
+    }
+
+    return QVector< QskAspect >( aspects.constBegin(), aspects.constEnd() );
+}
+
+static qint64 benchmark( const QskSkinHintTable& table,
+    const QVector< QskAspect >& aspects, int& found )
+{
+    found = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < qskLoops; i++ )
+    {
+        for ( const auto aspect : aspects )
+        {
+            if ( table.resolvedHint( aspect ) )
+                found++;
+        }
+    }
+
+    found /= qskLoops;
+
+    return timer.nsecsElapsed() / ( qskLoops * aspects.size() );
+}
+
+static void benchmark( const QString& skinName )
+{
+    auto skin = qskSkinManager->createSkin( skinName, QskSkin::LightScheme );
+
+    auto frozenTable = skin->hintTable();
+    frozenTable.freeze();
+
+    const auto table = hashTable( frozenTable );
+    const auto lookups = aspects( frozenTable );
+
+    int found1, found2;
+
+    const auto t1 = benchmark( table, lookups, found1 );
+    const auto t2 = benchmark( frozenTable, lookups, found2 );
+
+    qDebug().noquote() << skinName << ":" << table.hints().size() << "hints,"
+        << lookups.size() << "aspects," << found1 << "/" << found2 << "resolved,"
+        << t1 << "ns per lookup ( QHash )," << t2 << "ns per lookup ( FlatTable )";
+
+    delete skin;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    // populating all hints
+    qputenv( "QSK_EAGER_SKIN_HINTS", "1" );
+
+    for ( const auto& name : { "Material3", "Fluent2", "Fusion" } )
+        benchmark( name );
+
+    return 0;
+}
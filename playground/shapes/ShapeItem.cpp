@@ -145,6 +145,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
         BorderRole
     };
 
+    static const QVector< quint8 > roles = { FillRole, BorderRole };
+
     const auto rect = contentsRect();
 
     auto fillNode = static_cast< QskShapeNode* >(
@@ -155,8 +157,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
 
     if ( rect.isEmpty() || m_data->path.isEmpty() )
     {
-        delete fillNode;
-        delete borderNode;
+        QskSGNode::removeChildNode( parentNode, FillRole );
+        QskSGNode::removeChildNode( parentNode, BorderRole );
 
         return;
     }
@@ -168,9 +170,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
         if ( fillNode == nullptr )
         {
             fillNode = new QskShapeNode;
-            QskSGNode::setNodeRole( fillNode, FillRole );
-
-            parentNode->prependChildNode( fillNode );
+            QskSGNode::replaceChildNode(
+                roles, FillRole, parentNode, nullptr, fillNode );
         }
 
         auto fillRect = rect;
@@ -186,11 +187,11 @@ void ShapeItem::updateNode( QSGNode* parentNode )
 #endif
 
         const auto transform = ::transformForRects( pathRect, fillRect );
-        fillNode->updatePath( m_data->path, transform, fillRect, m_data->gradient );
+        fillNode->updatePath( window(), m_data->path, transform, fillRect, m_data->gradient );
     }
     else
     {
-        delete fillNode;
+        QskSGNode::removeChildNode( parentNode, FillRole );
     }
 
     if ( m_data->stroke.isVisible() )
@@ -216,9 +217,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
         if ( borderNode == nullptr )
         {
             borderNode = new QskStrokeNode;
-            QskSGNode::setNodeRole( borderNode, BorderRole );
-
-            parentNode->appendChildNode( borderNode );
+            QskSGNode::replaceChildNode(
+                roles, BorderRole, parentNode, nullptr, borderNode );
         }
 
         const auto transform = ::transformForRects( pathRect, rect );
@@ -226,7 +226,7 @@ void ShapeItem::updateNode( QSGNode* parentNode )
     }
     else
     {
-        delete borderNode;
+        QskSGNode::removeChildNode( parentNode, BorderRole );
     }
 }
 
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Benchmark for the memory of many identically customized controls,
+    comparing the local hint tables before and after sharing them
+    ( see QskSkinnable::shareSkinHints ).
+
+    The allocated memory is taken from the statistics of glibc and
+    is not available on other platforms.
+ */
+
+#include <QskPushButton.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskRgbValue.h>
+
+#include <QGuiApplication>
+#include <QDebug>
+#include <QVector>
+
+#if defined( __GLIBC__ ) && ( __GLIBC__ > 2 || __GLIBC_MINOR__ >= 33 )
+#define QSK_MALLINFO 1
+#include <malloc.h>
+#endif
+
+namespace
+{
+    class Button : public QskPushButton
+    {
+      public:
+        Button()
+        {
+            using Q = QskPushButton;
+
+            setColor( Q::Panel, QskRgb::SteelBlue );
+            setColor( Q::Splash, QskRgb::LightSteelBlue );
+            setColor( Q::Text, QskRgb::White );
+            setBoxShapeHint( Q::Panel, 4 );
+            setBoxBorderMetricsHint( Q::Panel, 1 );
+            setPaddingHint( Q::Panel, 8 );
+        }
+
+        void share()
+        {
+            shareSkinHints();
+        }
+    };
+}
+
+static qint64 qskAllocatedBytes()
+{
+#ifdef QSK_MALLINFO
+    return static_cast< qint64 >( mallinfo2().uordblks );
+#else
+    return -1;
+#endif
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    int count = 2000;
+    if ( argc > 1 )
+        count = qMax( 1, QByteArray( argv[1] ).toInt() );
+
+    QVector< Button* > buttons;
+    buttons.reserve( count );
+
+    const auto bytes0 = qskAllocatedBytes();
+
+    for ( int i = 0; i < count; i++ )
+        buttons += new Button();
+
+    const auto bytes1 = qskAllocatedBytes();
+
+    for ( auto button : std::as_const( buttons ) )
+        button->share();
+
+    const auto bytes2 = qskAllocatedBytes();
+
+    if ( bytes0 < 0 )
+    {
+        qDebug() << "No memory statistics available on this platform";
+    }
+    else
+    {
+        qDebug().noquote() << count << "buttons:"
+            << ( bytes1 - bytes0 ) / 1024 << "kB without sharing,"
+            << ( bytes2 - bytes0 ) / 1024 << "kB with sharing";
+    }
+
+    qDeleteAll( buttons );
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Benchmark for setting up the skins:
+
+    - populating all hints upfront compared with populating the hints
+      of the classes, that are in use. The classes are those of the
+      gallery example. The number of hints and the estimated size
+      of the hint table are reported as indicator for the memory.
+
+    - resolving a subcontrol of a base class ( QskControl::Background )
+      must not populate the hints of all derived classes.
+
+    - running initHints() compared with restoring a snapshot
+      ( see QskSkinSnapshot ) of the same skin.
+ */
+
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinSnapshot.h>
+
+#include <QskAspect.h>
+#include <QskCheckBox.h>
+#include <QskComboBox.h>
+#include <QskControl.h>
+#include <QskFocusIndicator.h>
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+#include <QskMainView.h>
+#include <QskMessageSubWindow.h>
+#include <QskPageIndicator.h>
+#include <QskProgressBar.h>
+#include <QskProgressRing.h>
+#include <QskPushButton.h>
+#include <QskRadioBox.h>
+#include <QskScrollArea.h>
+#include <QskSegmentedBar.h>
+#include <QskSelectionSubWindow.h>
+#include <QskSimpleListBox.h>
+#include <QskSlider.h>
+#include <QskSpinBox.h>
+#include <QskSwitchButton.h>
+#include <QskTabBar.h>
+#include <QskTabButton.h>
+#include <QskTabView.h>
+#include <QskTextField.h>
+#include <QskTextLabel.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QDebug>
+
+static const int qskLoops = 20;
+
+static const QMetaObject* qskGalleryClasses[] =
+{
+    &QskCheckBox::staticMetaObject,
+    &QskComboBox::staticMetaObject,
+    &QskFocusIndicator::staticMetaObject,
+    &QskGridBox::staticMetaObject,
+    &QskLinearBox::staticMetaObject,
+    &QskMainView::staticMetaObject,
+    &QskMessageSubWindow::staticMetaObject,
+    &QskPageIndicator::staticMetaObject,
+    &QskProgressBar::staticMetaObject,
+    &QskProgressRing::staticMetaObject,
+    &QskPushButton::staticMetaObject,
+    &QskRadioBox::staticMetaObject,
+    &QskScrollArea::staticMetaObject,
+    &QskSegmentedBar::staticMetaObject,
+    &QskSelectionSubWindow::staticMetaObject,
+    &QskSimpleListBox::staticMetaObject,
+    &QskSlider::staticMetaObject,
+    &QskSpinBox::staticMetaObject,
+    &QskSwitchButton::staticMetaObject,
+    &QskTabBar::staticMetaObject,
+    &QskTabButton::staticMetaObject,
+    &QskTabView::staticMetaObject,
+    &QskTextField::staticMetaObject,
+    &QskTextLabel::staticMetaObject
+};
+
+static void benchmark( const QString& skinName, bool eager )
+{
+    if ( eager )
+        qputenv( "QSK_EAGER_SKIN_HINTS", "1" );
+    else
+        qunsetenv( "QSK_EAGER_SKIN_HINTS" );
+
+    qint64 setupTime = 0;
+    qint64 populateTime = 0;
+    int hintCount = 0;
+    int baseHintCount = 0;
+
+    for ( int i = 0; i < qskLoops; i++ )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto skin = qskSkinManager->createSkin( skinName, QskSkin::LightScheme );
+
+        setupTime += timer.nsecsElapsed();
+        timer.restart();
+
+        // what happens for any control, when updating its background
+        skin->populateHints( QskControl::Background );
+        baseHintCount = skin->hintTable().hints().size();
+
+        for ( const auto metaObject : qskGalleryClasses )
+            skin->populateHints( metaObject );
+
+        populateTime += timer.nsecsElapsed();
+
+        hintCount = skin->hintTable().hints().size();
+        delete skin;
+    }
+
+    /*
+        A rough estimate of the hash: key, value and the overhead
+        of a node. The frozen table is not included.
+     */
+    const auto bytesPerHint = sizeof( QskAspect ) + sizeof( QVariant ) + 2 * sizeof( void* );
+
+    qDebug().noquote() << skinName << ( eager ? "eager:" : "lazy: " )
+        << setupTime / qskLoops / 1000 << "us setup,"
+        << populateTime / qskLoops / 1000 << "us populating the gallery classes,"
+        << baseHintCount << "hints after resolving QskControl::Background,"
+        << hintCount << "hints," << hintCount * bytesPerHint / 1024 << "kB";
+}
+
+static void benchmarkSnapshot( const QString& skinName, const QString& path )
+{
+    // a snapshot is always complete
+    qputenv( "QSK_EAGER_SKIN_HINTS", "1" );
+
+    const auto fileName = QStringLiteral( "%1/%2.qsksnapshot" ).arg( path, skinName );
+
+    auto skin = qskSkinManager->createSkin( skinName, QskSkin::LightScheme );
+
+    if ( !QskSkinSnapshot::write( skin, fileName ) )
+    {
+        qWarning() << skinName << ": writing the snapshot failed";
+        delete skin;
+
+        return;
+    }
+
+    qint64 initTime = 0;
+    qint64 readTime = 0;
+
+    for ( int i = 0; i < qskLoops; i++ )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        // includes creating the skin object
+        delete qskSkinManager->createSkin( skinName, QskSkin::LightScheme );
+
+        initTime += timer.nsecsElapsed();
+        timer.restart();
+
+        QskSkinSnapshot::read( skin, fileName );
+
+        readTime += timer.nsecsElapsed();
+    }
+
+    qDebug().noquote() << skinName << "snapshot:"
+        << initTime / qskLoops / 1000 << "us initHints,"
+        << readTime / qskLoops / 1000 << "us reading the snapshot";
+
+    delete skin;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    for ( const auto& name : { "Material3", "Fluent2", "Fusion" } )
+    {
+        // loading the plugin and the fonts
+        delete qskSkinManager->createSkin( name, QskSkin::LightScheme );
+
+        benchmark( name, true );
+        benchmark( name, false );
+    }
+
+    QTemporaryDir dir;
+
+    for ( const auto& name : { "Material3", "Fluent2", "Fusion" } )
+        benchmarkSnapshot( name, dir.path() );
+
+    return 0;
+}
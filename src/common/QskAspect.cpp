@@ -41,6 +41,7 @@ namespace
     struct AspectRegistry
     {
         QVector< QByteArray > subControlNames;
+        QVector< const QMetaObject* > subControlMetaObjects;
         unordered_map< const QMetaObject*, QVector< QskAspect::Subcontrol > > subControlTable;
         unordered_map< const QMetaObject*, QVector< StateInfo > > stateTable;
     };
@@ -100,6 +101,7 @@ QskAspect::Subcontrol QskAspect::nextSubcontrol(
         " QskAspect::Subcontrol in QskAspect.h." );
 
     names += name;
+    qskAspectRegistry->subControlMetaObjects += metaObject;
 
     // 0 is QskAspect::Control, so we have to start with 1
     const auto subControl = static_cast< Subcontrol >( names.size() );
@@ -119,6 +121,17 @@ QByteArray QskAspect::subControlName( Subcontrol subControl )
     return QByteArray();
 }
 
+const QMetaObject* QskAspect::subControlMetaObject( Subcontrol subControl )
+{
+    const auto& metaObjects = qskAspectRegistry->subControlMetaObjects;
+
+    const int index = subControl;
+    if ( index > 0 && index <= metaObjects.size() )
+        return metaObjects[ index - 1 ];
+
+    return nullptr;
+}
+
 QVector< QByteArray > QskAspect::subControlNames( const QMetaObject* metaObject )
 {
     const auto& names = qskAspectRegistry->subControlNames;
@@ -7,11 +7,15 @@
 
 #include <qeasingcurve.h>
 #include <qimage.h>
+#include <qvarlengtharray.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qdrawhelper_p.h>
+#include <private/qsimd_p.h>
 QSK_QT_PRIVATE_END
 
+#include <algorithm>
+
 namespace
 {
     inline int value( int from, int to, qreal ratio )
@@ -206,64 +210,48 @@ void QskRgb::debugColor( QDebug debug, QRgb rgb )
 
 QImage QskRgb::colorTable( int size, const QskGradientStops& stops )
 {
-    if ( size == 0 || stops.isEmpty() )
+    if ( size <= 0 || stops.isEmpty() )
         return QImage();
 
     QImage image( size, 1, QImage::Format_RGBA8888_Premultiplied );
+    colorTable( size, stops, reinterpret_cast< uint* >( image.bits() ) );
 
-    if ( stops.size() == 1 )
-    {
-        const auto rgb = ARGB2RGBA( qPremultiply( stops[0].rgb() ) );
-        image.fill( rgb );
+    return image;
+}
 
-        return image;
-    }
+void QskRgb::colorTable( const int size,
+    const QskGradientStops& stops, uint* values )
+{
+    if ( size <= 0 || stops.isEmpty() )
+        return;
 
-    auto values = reinterpret_cast< uint* >( image.bits() );
+    QVarLengthArray< QRgb, 16 > rgbs( stops.count() );
+    for ( int i = 0; i < stops.count(); i++ )
+        rgbs[i] = stops[i].rgb();
 
-    int index1, index2;
-    QRgb rgb1, rgb2;
+    premultiply( rgbs.data(), rgbs.count() );
 
-    index1 = index2 = qRound( stops[0].position() * size );
-    rgb1 = rgb2 = qPremultiply( stops[0].rgb() );
+    for ( auto& rgb : rgbs )
+        rgb = ARGB2RGBA( rgb );
 
-    if ( index1 > 0 )
+    if ( rgbs.count() == 1 )
     {
-        const auto v = ARGB2RGBA( rgb1 );
-
-        for ( int i = 0; i < index1; i++ )
-            values[i] = v;
+        std::fill_n( values, size, rgbs[0] );
+        return;
     }
 
+    int index1 = qBound( 0, qRound( stops[0].position() * size ), size );
+    std::fill_n( values, index1, rgbs[0] );
+
     for ( int i = 1; i < stops.count(); i++ )
     {
-        const auto& stop = stops[i];
-
-        index2 = qRound( stop.position() * size );
-        rgb2 = qPremultiply( stop.rgb() );
-
-        const auto n = index2 - index1;
-
-        values[ index1 ] = ARGB2RGBA( rgb1 );
-        for ( int j = 1; j < n; j++ )
-        {
-            const auto rgb = QskRgb::interpolated( rgb1, rgb2, qreal( j ) / ( n - 1 ) );
-            values[ index1 + j] = ARGB2RGBA( rgb );
-        }
+        const int index2 = qBound( index1, qRound( stops[i].position() * size ), size );
 
+        interpolate( rgbs[i - 1], rgbs[i], values + index1, index2 - index1 );
         index1 = index2;
-        rgb1 = rgb2;
     }
 
-    if ( index1 < size - 1 )
-    {
-        const auto v = ARGB2RGBA( rgb1 );
-
-        for ( int i = index1; i < size ; i++ )
-            values[i] = v;
-    }
-
-    return image;
+    std::fill_n( values + index1, size - index1, rgbs.last() );
 }
 
 QImage QskRgb::colorTable( const int size,
@@ -296,3 +284,183 @@ QImage QskRgb::colorTable( const int size,
 
     return image;
 }
+
+#if defined( __SSE2__ )
+
+static inline __m128 qskUnpackedF( const QRgb rgb )
+{
+    const auto zero = _mm_setzero_si128();
+
+    auto v = _mm_cvtsi32_si128( static_cast< int >( rgb ) );
+    v = _mm_unpacklo_epi8( v, zero );
+    v = _mm_unpacklo_epi16( v, zero );
+
+    return _mm_cvtepi32_ps( v );
+}
+
+static void qskInterpolate( const QRgb rgb1, const QRgb rgb2, QRgb* values, int count )
+{
+    const auto c1 = qskUnpackedF( rgb1 );
+    const auto delta = _mm_sub_ps( qskUnpackedF( rgb2 ), c1 );
+
+    const float step = 1.0f / ( count - 1 );
+
+    int i = 0;
+
+    for ( ; i + 3 < count; i += 4 )
+    {
+        __m128i v[4];
+
+        for ( int j = 0; j < 4; j++ )
+        {
+            const auto t = _mm_set1_ps( ( i + j ) * step );
+            v[j] = _mm_cvttps_epi32( _mm_add_ps( c1, _mm_mul_ps( delta, t ) ) );
+        }
+
+        const auto v01 = _mm_packs_epi32( v[0], v[1] );
+        const auto v23 = _mm_packs_epi32( v[2], v[3] );
+
+        _mm_storeu_si128( reinterpret_cast< __m128i* >( values + i ),
+            _mm_packus_epi16( v01, v23 ) );
+    }
+
+    for ( ; i < count; i++ )
+    {
+        const auto t = _mm_set1_ps( i * step );
+        auto v = _mm_cvttps_epi32( _mm_add_ps( c1, _mm_mul_ps( delta, t ) ) );
+
+        v = _mm_packs_epi32( v, v );
+        values[i] = static_cast< QRgb >( _mm_cvtsi128_si32( _mm_packus_epi16( v, v ) ) );
+    }
+}
+
+static inline __m128i qskPremultiplied( __m128i v )
+{
+    // 2 pixels with 16 bit channels, the result is identical to qPremultiply
+
+    const auto alphaMask = _mm_set_epi16( 0xff, 0, 0, 0, 0xff, 0, 0, 0 );
+
+    auto alpha = _mm_shufflelo_epi16( v, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    alpha = _mm_shufflehi_epi16( alpha, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+    alpha = _mm_or_si128( alpha, alphaMask ); // alpha * 255 / 255 = alpha
+
+    v = _mm_mullo_epi16( v, alpha );
+    v = _mm_add_epi16( v, _mm_srli_epi16( v, 8 ) );
+    v = _mm_add_epi16( v, _mm_set1_epi16( 0x80 ) );
+
+    return _mm_srli_epi16( v, 8 );
+}
+
+static void qskPremultiply( QRgb* values, int count )
+{
+    const auto zero = _mm_setzero_si128();
+
+    int i = 0;
+
+    for ( ; i + 3 < count; i += 4 )
+    {
+        auto p = reinterpret_cast< __m128i* >( values + i );
+
+        const auto v = _mm_loadu_si128( p );
+
+        const auto lo = qskPremultiplied( _mm_unpacklo_epi8( v, zero ) );
+        const auto hi = qskPremultiplied( _mm_unpackhi_epi8( v, zero ) );
+
+        _mm_storeu_si128( p, _mm_packus_epi16( lo, hi ) );
+    }
+
+    for ( ; i < count; i++ )
+        values[i] = qPremultiply( values[i] );
+}
+
+#elif defined( __ARM_NEON__ ) && ( Q_BYTE_ORDER == Q_LITTLE_ENDIAN )
+
+static inline float32x4_t qskUnpackedF( const QRgb rgb )
+{
+    const auto v8 = vreinterpret_u8_u32( vdup_n_u32( rgb ) );
+    const auto v16 = vget_low_u16( vmovl_u8( v8 ) );
+
+    return vcvtq_f32_u32( vmovl_u16( v16 ) );
+}
+
+static void qskInterpolate( const QRgb rgb1, const QRgb rgb2, QRgb* values, int count )
+{
+    const auto c1 = qskUnpackedF( rgb1 );
+    const auto delta = vsubq_f32( qskUnpackedF( rgb2 ), c1 );
+
+    const float step = 1.0f / ( count - 1 );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto v32 = vcvtq_u32_f32( vmlaq_n_f32( c1, delta, i * step ) );
+        const auto v16 = vmovn_u32( v32 );
+        const auto v8 = vmovn_u16( vcombine_u16( v16, v16 ) );
+
+        values[i] = vget_lane_u32( vreinterpret_u32_u8( v8 ), 0 );
+    }
+}
+
+static void qskPremultiply( QRgb* values, int count )
+{
+    int i = 0;
+
+    for ( ; i + 7 < count; i += 8 )
+    {
+        auto p = reinterpret_cast< uint8_t* >( values + i );
+
+        auto v = vld4_u8( p ); // b, g, r, a
+        const auto alpha = v.val[3];
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            // ( x * a + ( ( x * a ) >> 8 ) + 0x80 ) >> 8, like qPremultiply
+
+            const auto t = vmull_u8( v.val[j], alpha );
+            v.val[j] = vrshrn_n_u16( vsraq_n_u16( t, t, 8 ), 8 );
+        }
+
+        vst4_u8( p, v );
+    }
+
+    for ( ; i < count; i++ )
+        values[i] = qPremultiply( values[i] );
+}
+
+#else
+
+static void qskInterpolate( const QRgb rgb1, const QRgb rgb2, QRgb* values, int count )
+{
+    for ( int i = 0; i < count; i++ )
+        values[i] = QskRgb::interpolated( rgb1, rgb2, qreal( i ) / ( count - 1 ) );
+}
+
+static void qskPremultiply( QRgb* values, int count )
+{
+    for ( int i = 0; i < count; i++ )
+        values[i] = qPremultiply( values[i] );
+}
+
+#endif
+
+void QskRgb::interpolate( const QRgb rgb1, const QRgb rgb2, QRgb* values, int count )
+{
+    if ( count <= 0 )
+        return;
+
+    if ( ( rgb1 == rgb2 ) || ( count == 1 ) )
+    {
+        std::fill_n( values, count, rgb1 );
+        return;
+    }
+
+    qskInterpolate( rgb1, rgb2, values, count );
+
+    // avoiding rounding errors for the last value
+    values[ count - 1 ] = rgb2;
+}
+
+void QskRgb::premultiply( QRgb* values, int count )
+{
+    if ( count > 0 )
+        qskPremultiply( values, count );
+}
@@ -232,6 +232,27 @@ namespace QskRgb
 
     QSK_EXPORT QImage colorTable( int size, const QskGradientStops& );
     QSK_EXPORT QImage colorTable( int size, QRgb, QRgb, const QEasingCurve& );
+
+    // writing size values of Format_RGBA8888_Premultiplied to values
+    QSK_EXPORT void colorTable( int size, const QskGradientStops&, uint* values );
+}
+
+namespace QskRgb
+{
+    /*
+        Batch operations, that are vectorized ( SSE2/NEON ) when
+        supported by the target platform.
+     */
+
+    /*
+        Interpolating count values from rgb1 to rgb2 - both included.
+        As the channels are interpolated independently it does not matter
+        if the values are ARGB or RGBA.
+     */
+    QSK_EXPORT void interpolate( QRgb rgb1, QRgb rgb2, QRgb* values, int count );
+
+    // in place conversion from ARGB32 to ARGB32_Premultiplied
+    QSK_EXPORT void premultiply( QRgb* values, int count );
 }
 
 #ifndef QT_NO_DEBUG_STREAM
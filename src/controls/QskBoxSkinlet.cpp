@@ -10,6 +10,7 @@ QskBoxSkinlet::QskBoxSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
     setNodeRoles( { PanelRole } );
+    setNodeRoleSubcontrol( PanelRole, QskBox::Panel );
 }
 
 QskBoxSkinlet::~QskBoxSkinlet()
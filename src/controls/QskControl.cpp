@@ -890,6 +890,9 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
 void QskControl::geometryChange(
     const QRectF& newGeometry, const QRectF& oldGeometry )
 {
+    if ( newGeometry.size() != oldGeometry.size() )
+        setAllSubcontrolsDirty();
+
     if ( d_func()->autoLayoutChildren )
     {
         if ( newGeometry.size() != oldGeometry.size() )
@@ -901,6 +904,13 @@ void QskControl::geometryChange(
 
 void QskControl::updateItemPolish()
 {
+    /*
+        Polishing happens after the animators have been advanced and
+        we don't know which updates are requested by updateLayout.
+     */
+    setAllSubcontrolsDirty();
+
+    shareSkinHints();
     updateResources(); // an extra dirty bit for this ???
 
     if ( width() >= 0.0 || height() >= 0.0 )
@@ -927,9 +937,14 @@ void QskControl::updateItemPolish()
 QSGNode* QskControl::updateItemPaintNode( QSGNode* node )
 {
     if ( node == nullptr )
+    {
         node = new QskTreeNode();
+        setAllSubcontrolsDirty();
+    }
 
+    startNodeUpdate();
     updateNode( node );
+
     return node;
 }
 
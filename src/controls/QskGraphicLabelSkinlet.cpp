@@ -17,6 +17,9 @@ QskGraphicLabelSkinlet::QskGraphicLabelSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
     setNodeRoles( { PanelRole, GraphicRole } );
+
+    setNodeRoleSubcontrol( PanelRole, QskGraphicLabel::Panel );
+    setNodeRoleSubcontrol( GraphicRole, QskGraphicLabel::Graphic );
 }
 
 QskGraphicLabelSkinlet::~QskGraphicLabelSkinlet() = default;
@@ -149,15 +149,24 @@ void QskHintAnimator::advance( qreal progress )
     {
         if ( m_updateFlags == QskAnimationHint::UpdateAuto )
         {
-            if ( !m_aspect.isColor() )
+            if ( m_aspect.isColor() )
+            {
+                // only the nodes of the subcontrol/sample are affected
+                if ( m_index >= 0 )
+                    m_control->setSampleDirty( m_index );
+                else
+                    m_control->setSubcontrolDirty( m_aspect.subControl() );
+            }
+            else
             {
                 m_control->resetImplicitSize();
 
                 if ( !m_control->childItems().isEmpty() )
                     m_control->polish();
-            }
 
-            m_control->update();
+                m_control->setAllSubcontrolsDirty();
+                m_control->update();
+            }
         }
         else
         {
@@ -10,6 +10,8 @@
 #include "QskSetup.h"
 #include "QskSkinManager.h"
 #include "QskSkin.h"
+#include "QskSkinDiff.h"
+#include "QskControl.h"
 #include "QskDirtyItemFilter.h"
 
 #include <qglobalstatic.h>
@@ -79,7 +81,7 @@ namespace
                 qskSkinManager, [ this ] { updateSkin(); } );
 
             QObject::connect( qskSkinManager, &QskSkinManager::colorSchemeChanged,
-                qskSkinManager, [ this ] { updateSkin(); } );
+                qskSkinManager, [ this ] { updateColorScheme(); } );
         }
 
         inline void insert( QskItem* item )
@@ -111,6 +113,49 @@ namespace
             }
         }
 
+        void updateColorScheme()
+        {
+            const auto skin = qskSkinManager->skin();
+            if ( skin == nullptr )
+                return;
+
+            const auto& changes = skin->colorSchemeChanges();
+
+            if ( changes.isGlobal() )
+            {
+                updateSkin();
+                return;
+            }
+
+            if ( changes.isEmpty() )
+                return;
+
+            /*
+                Most hints - f.e. the metrics - are the same for all color
+                schemes. So we restyle only the controls, that depend on
+                the modified subcontrols. Items, that are no controls,
+                have no hints to check and are always restyled.
+             */
+            QEvent event( QEvent::StyleChange );
+
+            for ( auto item : m_items )
+            {
+                bool isAffected = true;
+
+                if ( auto control = qskControlCast( item ) )
+                {
+                    isAffected = ( control->effectiveSkin() == skin )
+                        && changes.isAffected( control );
+                }
+
+                if ( isAffected )
+                {
+                    event.setAccepted( true );
+                    QCoreApplication::sendEvent( item, &event );
+                }
+            }
+        }
+
       private:
         std::unordered_set< QskItem* > m_items;
     };
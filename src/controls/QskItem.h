@@ -52,6 +52,7 @@ class QSK_EXPORT QskItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        AsynchronousTextures    =  1 << 5,
 
         DebugForceBackground    =  1 << 7
     };
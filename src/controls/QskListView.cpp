@@ -10,7 +10,9 @@
 #include "QskSkinlet.h"
 
 #include <qguiapplication.h>
+#include <qhash.h>
 #include <qstylehints.h>
+#include <qvector.h>
 
 #include <qmath.h>
 
@@ -28,15 +30,209 @@ static inline int qskRowAt( const QskListView* listView, const QPointF& pos )
     if ( rect.contains( pos ) )
     {
         const auto y = pos.y() - rect.top() + listView->scrollPos().y();
-
-        const int row = y / listView->rowHeight();
-        if ( row >= 0 && row < listView->rowCount() )
-            return row;
+        return listView->rowAt( y );
     }
 
     return -1;
 }
 
+namespace
+{
+    /*
+        A Fenwick tree for the rows with individual heights, so that
+        the position of a row and the row at a position can be found in O(log n).
+
+        Each node stores the sum of the individual heights and the number of rows
+        having one. This way the other rows can be calculated from the default
+        height, which might change at any time - f.e. with the font.
+     */
+    class RowHeightIndex
+    {
+      public:
+        bool isEmpty() const
+        {
+            return m_heights.isEmpty();
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_nodes.clear();
+        }
+
+        void resize( int rowCount )
+        {
+            if ( rowCount == m_rowCount )
+                return;
+
+            if ( m_nodes.isEmpty() )
+            {
+                m_rowCount = rowCount;
+                return;
+            }
+
+            if ( rowCount < m_rowCount )
+            {
+                // the remaining nodes do not cover any of the removed rows
+                m_nodes.resize( rowCount + 1 );
+
+                for ( auto it = m_heights.begin(); it != m_heights.end(); )
+                {
+                    if ( it.key() >= rowCount )
+                        it = m_heights.erase( it );
+                    else
+                        ++it;
+                }
+
+                if ( m_heights.isEmpty() )
+                    m_nodes.clear();
+            }
+            else
+            {
+                m_nodes.resize( rowCount + 1 );
+
+                for ( int i = m_rowCount + 1; i <= rowCount; i++ )
+                {
+                    // the new row has no individual height
+                    m_nodes[ i ] = prefix( i - 1 ) - prefix( i - ( i & -i ) );
+                }
+            }
+
+            m_rowCount = rowCount;
+        }
+
+        void setHeight( int row, qreal height )
+        {
+            if ( row < 0 || row >= m_rowCount )
+                return;
+
+            if ( m_nodes.isEmpty() )
+                m_nodes.fill( Node(), m_rowCount + 1 );
+
+            Node delta { height, 1 };
+
+            auto it = m_heights.find( row );
+            if ( it != m_heights.end() )
+            {
+                delta = { height - it.value(), 0 };
+                it.value() = height;
+            }
+            else
+            {
+                m_heights.insert( row, height );
+            }
+
+            add( row, delta );
+        }
+
+        void resetHeight( int row )
+        {
+            auto it = m_heights.find( row );
+            if ( it == m_heights.end() )
+                return;
+
+            add( row, { -it.value(), -1 } );
+            m_heights.erase( it );
+
+            if ( m_heights.isEmpty() )
+                m_nodes.clear();
+        }
+
+        qreal height( int row, qreal defaultHeight ) const
+        {
+            return m_heights.value( row, defaultHeight );
+        }
+
+        // the sum of the heights of the rows before row
+        qreal position( int row, qreal defaultHeight ) const
+        {
+            if ( m_nodes.isEmpty() )
+                return row * defaultHeight;
+
+            const auto node = prefix( qBound( 0, row, m_rowCount ) );
+            return node.sum + ( row - node.count ) * defaultHeight;
+        }
+
+        // the row at y, might be out of range
+        int rowAt( qreal y, qreal defaultHeight ) const
+        {
+            if ( m_nodes.isEmpty() || y < 0.0 )
+                return qFloor( y / defaultHeight );
+
+            int row = 0;
+
+            int step = 1;
+            while ( 2 * step <= m_rowCount )
+                step *= 2;
+
+            for ( ; step > 0; step /= 2 )
+            {
+                const int next = row + step;
+                if ( next <= m_rowCount )
+                {
+                    // the node covers the rows [ row, next [
+                    const auto& node = m_nodes[ next ];
+                    const auto h = node.sum + ( step - node.count ) * defaultHeight;
+
+                    if ( h <= y )
+                    {
+                        row = next;
+                        y -= h;
+                    }
+                }
+            }
+
+            if ( row == m_rowCount )
+                row += qFloor( y / defaultHeight );
+
+            return row;
+        }
+
+      private:
+        class Node
+        {
+          public:
+            inline Node operator-( const Node& other ) const
+            {
+                return { sum - other.sum, count - other.count };
+            }
+
+            inline Node& operator+=( const Node& other )
+            {
+                sum += other.sum;
+                count += other.count;
+
+                return *this;
+            }
+
+            qreal sum = 0.0;
+            int count = 0;
+        };
+
+        Node prefix( int rowCount ) const
+        {
+            Node node;
+            for ( int i = rowCount; i > 0; i -= ( i & -i ) )
+                node += m_nodes[ i ];
+
+            return node;
+        }
+
+        void add( int row, const Node& delta )
+        {
+            for ( int i = row + 1; i <= m_rowCount; i += ( i & -i ) )
+                m_nodes[ i ] += delta;
+        }
+
+        int m_rowCount = 0;
+
+        // 1-based, empty as long as there are no individual heights
+        QVector< Node > m_nodes;
+
+        QHash< int, qreal > m_heights;
+    };
+}
+
 class QskListView::PrivateData
 {
   public:
@@ -72,6 +268,13 @@ class QskListView::PrivateData
         listView->update();
     }
 
+    RowHeightIndex& syncedRowHeights( const QskListView* listView )
+    {
+        // the number of rows might have changed in the meantime
+        rowHeights.resize( listView->rowCount() );
+        return rowHeights;
+    }
+
   private:
     inline void startTransitions( QskListView* listView, int row,
         QskAspect::States oldStates, QskAspect::States newStates )
@@ -95,6 +298,10 @@ class QskListView::PrivateData
     int hoveredRow = -1;
     int pressedRow = -1;
     int selectedRow = -1;
+
+    int overscan = 0;
+
+    RowHeightIndex rowHeights;
 };
 
 QskListView::QskListView( QQuickItem* parent )
@@ -202,6 +409,80 @@ QskListView::SelectionMode QskListView::selectionMode() const
     return m_data->selectionMode;
 }
 
+void QskListView::setRowHeight( int row, qreal height )
+{
+    if ( row < 0 || row >= rowCount() )
+        return;
+
+    height = qMax( height, 0.0 );
+
+    auto& rowHeights = m_data->syncedRowHeights( this );
+    if ( rowHeights.height( row, -1.0 ) != height )
+    {
+        rowHeights.setHeight( row, height );
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeight( int row )
+{
+    auto& rowHeights = m_data->syncedRowHeights( this );
+    if ( rowHeights.height( row, -1.0 ) >= 0.0 )
+    {
+        rowHeights.resetHeight( row );
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeights()
+{
+    if ( !m_data->rowHeights.isEmpty() )
+    {
+        m_data->rowHeights.clear();
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+qreal QskListView::rowHeightAt( int row ) const
+{
+    return m_data->syncedRowHeights( this ).height( row, rowHeight() );
+}
+
+qreal QskListView::rowPosition( int row ) const
+{
+    return m_data->syncedRowHeights( this ).position( row, rowHeight() );
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    const int row = m_data->syncedRowHeights( this ).rowAt( y, rowHeight() );
+    return ( row >= 0 && row < rowCount() ) ? row : -1;
+}
+
+void QskListView::setOverscan( int rows )
+{
+    rows = qMax( rows, 0 );
+
+    if ( rows != m_data->overscan )
+    {
+        m_data->overscan = rows;
+        update();
+
+        Q_EMIT overscanChanged( rows );
+    }
+}
+
+int QskListView::overscan() const
+{
+    return m_data->overscan;
+}
+
 QRectF QskListView::focusIndicatorRect() const
 {
 #if FOCUS_ON_CURRENT
@@ -281,7 +562,7 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowPosition( row );
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -291,9 +572,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeightAt( row ) > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeightAt( row ) - vr.height();
                 pos.setY( y );
             }
         }
@@ -398,19 +679,25 @@ QskAspect::States QskListView::rowStates( int row ) const
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 )
+            y = listView->rowPosition( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const auto row = listView->rowAt( y );
+        if ( row >= 0 && listView->rowPosition( row ) < y )
+            y = listView->rowPosition( row + 1 );
+
         y -= viewHeight;
     }
 
@@ -457,7 +744,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -471,7 +758,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    const double h = rowPosition( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
@@ -26,6 +26,9 @@ class QSK_EXPORT QskListView : public QskScrollView
     Q_PROPERTY( bool preferredWidthFromColumns READ preferredWidthFromColumns
         WRITE setPreferredWidthFromColumns NOTIFY preferredWidthFromColumnsChanged() )
 
+    Q_PROPERTY( int overscan READ overscan
+        WRITE setOverscan NOTIFY overscanChanged FINAL )
+
     using Inherited = QskScrollView;
 
   public:
@@ -49,6 +52,13 @@ class QSK_EXPORT QskListView : public QskScrollView
     void setSelectionMode( SelectionMode );
     SelectionMode selectionMode() const;
 
+    /*
+        Number of rows above/below the viewport, that are kept
+        prebuilt in the scene graph to have them ready when scrolling
+     */
+    void setOverscan( int rows );
+    int overscan() const;
+
     void setTextOptions( const QskTextOptions& textOptions );
     void resetTextOptions();
     QskTextOptions textOptions() const;
@@ -62,6 +72,25 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    /*
+        Rows have the height of rowHeight() unless an individual
+        height has been set. Individual heights are bound to the index
+        of the row and need to be reset, when rows are inserted/removed.
+
+        Positions and lookups by position are done in O(log n).
+     */
+    void setRowHeight( int row, qreal height );
+    void resetRowHeight( int row );
+    void resetRowHeights();
+
+    qreal rowHeightAt( int row ) const;
+
+    // the y coordinate of the top of a row
+    qreal rowPosition( int row ) const;
+
+    // -1, when there is no row at y
+    int rowAt( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
     QRectF focusIndicatorRect() const override;
@@ -74,6 +103,7 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void selectionModeChanged();
     void preferredWidthFromColumnsChanged();
+    void overscanChanged( int );
     void textOptionsChanged();
 
   protected:
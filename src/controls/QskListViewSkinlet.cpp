@@ -13,10 +13,12 @@
 #include "QskSkinStateChanger.h"
 #include "QskQuick.h"
 
-#include <qmath.h>
 #include <qsgnode.h>
 #include <qtransform.h>
 
+// the maximum number of rows, that are kept for being recycled
+static const int qskMaxPooledRows = 10;
+
 namespace
 {
     class ForegroundNode : public QSGNode
@@ -24,12 +26,65 @@ namespace
       public:
         void invalidate()
         {
-            removeAllChildNodes();
+            QskSGNode::removeAllChildNodesFrom( this, firstChild() );
+            clearPool();
+
             m_columnCount = m_oldRowMin = m_oldRowMax = -1;
         }
 
+        /*
+            The number of rows changes, whenever partially visible rows
+            appear/disappear. Instead of deleting the nodes of the trailing
+            rows we keep them for being rebound to other rows later.
+         */
+        void recycleNodesFrom( QSGNode* node )
+        {
+            const int maxCount = qskMaxPooledRows * qMax( m_columnCount, 1 );
+
+            while ( node )
+            {
+                auto nextNode = node->nextSibling();
+
+                removeChildNode( node );
+
+                if ( m_poolCount < maxCount )
+                {
+                    m_pool.appendChildNode( node );
+                    m_poolCount++;
+                }
+                else
+                {
+                    if ( node->flags() & QSGNode::OwnedByParent )
+                        delete node;
+                }
+
+                node = nextNode;
+            }
+        }
+
+        QSGTransformNode* takeRecycledNode()
+        {
+            /*
+                Complete rows are recycled and taken in the same column order.
+                So we usually get a node of the same type and size.
+             */
+            auto node = m_pool.firstChild();
+            if ( node )
+            {
+                m_pool.removeChildNode( node );
+                m_poolCount--;
+
+                Q_ASSERT( node->type() == QSGNode::TransformNodeType );
+            }
+
+            return static_cast< QSGTransformNode* >( node );
+        }
+
         void rearrangeNodes( int rowMin, int rowMax, int columnCount )
         {
+            if ( columnCount != m_columnCount )
+                clearPool();
+
             const bool doReorder = ( columnCount == m_columnCount )
                 && ( rowMin <= m_oldRowMax ) && ( rowMax >= m_oldRowMin );
 
@@ -81,6 +136,12 @@ namespace
         }
 
       private:
+        void clearPool()
+        {
+            QskSGNode::removeAllChildNodesFrom( &m_pool, m_pool.firstChild() );
+            m_poolCount = 0;
+        }
+
         /*
             When scrolling the majority of the child nodes are simply translated
             while only few rows appear/disappear. To implement this in an efficient
@@ -90,6 +151,10 @@ namespace
         int m_oldRowMin = -1;
         int m_oldRowMax = -1;
         int m_columnCount = -1;
+
+        // detached nodes of previously visible rows
+        QSGNode m_pool;
+        int m_poolCount = 0;
     };
 
     class ListViewNode final : public QSGTransformNode
@@ -110,15 +175,28 @@ namespace
             setMatrix( QTransform::fromTranslate( -scrollPos.x(), -scrollPos.y() ) );
 
             m_clipRect = listView->viewContentsRect();
-            m_rowHeight = listView->rowHeight();
 
-            m_rowMin = qFloor( scrollPos.y() / m_rowHeight );
+            const auto numRows = listView->rowCount();
+
+            const auto y1 = scrollPos.y();
+            const auto y2 = y1 + m_clipRect.height() - 10e-6;
 
-            const auto rowMax = ( scrollPos.y() + m_clipRect.height() ) / m_rowHeight;
-            m_rowMax = qFloor( rowMax - 10e-6 );
+            m_rowMin = listView->rowAt( y1 );
+            if ( m_rowMin < 0 )
+                m_rowMin = ( y1 < 0.0 ) ? 0 : numRows;
 
-            if ( m_rowMax >= listView->rowCount() )
-                m_rowMax = listView->rowCount() - 1;
+            m_rowMax = listView->rowAt( y2 );
+            if ( m_rowMax < 0 )
+                m_rowMax = ( y2 < 0.0 ) ? -1 : numRows - 1;
+
+            // prebuilding rows outside of the viewport
+            const int overscan = listView->overscan();
+
+            m_rowMin = qMax( m_rowMin - overscan, 0 );
+            m_rowMax += overscan;
+
+            if ( m_rowMax >= numRows )
+                m_rowMax = numRows - 1;
         }
 
         QRectF clipRect() const { return m_clipRect; }
@@ -127,8 +205,6 @@ namespace
         int rowMax() const { return m_rowMax; }
         int rowCount() const { return m_rowMax - m_rowMin + 1; }
 
-        int rowHeight() const { return m_rowHeight; }
-
         QSGNode* backgroundNode() { return &m_backgroundNode; }
         ForegroundNode* foregroundNode() { return &m_foregroundNode; }
 
@@ -136,7 +212,6 @@ namespace
         // caching some calculations to speed things up
 
         QRectF m_clipRect;
-        qreal m_rowHeight;
 
         int m_rowMin, m_rowMax;
 
@@ -255,8 +330,7 @@ void QskListViewSkinlet::updateForegroundNodes(
     // finally putting the nodes into their position
     auto node = foregroundNode->firstChild();
 
-    const auto rowHeight = listView->rowHeight();
-    auto y = clipRect.top() + rowMin * rowHeight;
+    auto y = clipRect.top() + listView->rowPosition( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
@@ -274,7 +348,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += listView->rowHeightAt( row );
     }
 }
 
@@ -282,16 +356,26 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     const QskListView* listView, QSGNode* parentNode,
     int rowMin, int rowMax, const QMarginsF& margins ) const
 {
+    auto foregroundNode = static_cast< ForegroundNode* >( parentNode );
+
     auto node = parentNode->firstChild();
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        const auto h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+        const auto h = listView->rowHeightAt( row ) - ( margins.top() + margins.bottom() );
 
         for ( int col = 0; col < listView->columnCount(); col++ )
         {
             const auto w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
+            if ( node == nullptr )
+            {
+                // rebinding the node of a previous row instead of creating a new one
+                node = foregroundNode->takeRecycledNode();
+                if ( node )
+                    parentNode->appendChildNode( node );
+            }
+
             node = updateForegroundNode( listView,
                 parentNode, static_cast< QSGTransformNode* >( node ),
                 row, col, QSizeF( w, h ) );
@@ -300,7 +384,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
         }
     }
 
-    QskSGNode::removeAllChildNodesFrom( parentNode, node );
+    foregroundNode->recycleNodesFrom( node );
 }
 
 QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
@@ -313,61 +397,39 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
         Text nodes already have a transform root node - to avoid inserting extra
         transform nodes, the code below becomes a bit more complicated.
      */
-    QSGTransformNode* newCellNode = nullptr;
+    QSGNode* oldNode = nullptr;
 
-    if ( cellNode && ( cellNode->type() == QSGNode::TransformNodeType ) )
+    if ( cellNode )
     {
-        QSGNode* oldNode = cellNode;
+        oldNode = ( QskSGNode::nodeRole( cellNode ) == TextRole )
+            ? cellNode : cellNode->firstChild();
+    }
 
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
-        if ( newNode )
-        {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                newCellNode = new QSGTransformNode();
-                newCellNode->appendChildNode( newNode );
-            }
-        }
+    auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+
+    QSGTransformNode* newCellNode = nullptr;
+
+    if ( newNode && ( newNode->type() == QSGNode::TransformNodeType ) )
+    {
+        newCellNode = static_cast< QSGTransformNode* >( newNode );
     }
     else
     {
-        QSGNode* oldNode = cellNode ? cellNode->firstChild() : nullptr;
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+        // reusing the transform node, that has been wrapped around the old content
+        if ( cellNode && ( cellNode != oldNode ) )
+            newCellNode = cellNode;
+        else
+            newCellNode = new QSGTransformNode();
 
-        if ( newNode )
+        if ( newNode != newCellNode->firstChild() )
         {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                if ( cellNode == nullptr )
-                {
-                    newCellNode = new QSGTransformNode();
-                    newCellNode->appendChildNode( newNode );
-                }
-                else
-                {
-                    if ( newNode != oldNode )
-                    {
-                        delete cellNode->firstChild();
-                        cellNode->appendChildNode( newNode );
+            delete newCellNode->firstChild();
 
-                        newCellNode = cellNode;
-                    }
-                }
-            }
+            if ( newNode )
+                newCellNode->appendChildNode( newNode );
         }
     }
 
-    if ( newCellNode == nullptr )
-        newCellNode = new QSGTransformNode();
-
     if ( cellNode != newCellNode )
     {
         if ( cellNode )
@@ -485,9 +547,9 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
         const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
 
         const auto w = clipRect.width();
-        const auto h = listView->rowHeight();
+        const auto h = listView->rowHeightAt( index );
         const auto x = clipRect.left() + listView->scrollPos().x();
-        const auto y = clipRect.top() + index * h;
+        const auto y = clipRect.top() + listView->rowPosition( index );
 
         return QRectF( x, y, w, h );
     }
@@ -211,6 +211,12 @@ QskMenuSkinlet::QskMenuSkinlet( QskSkin* skin )
     , m_data( new PrivateData() )
 {
     appendNodeRoles( { ContentsRole, PanelRole } );
+
+    using Q = QskMenu;
+
+    // the contents node is made of the nodes of several subcontrols
+    setNodeRoleSubcontrols( ContentsRole, { Q::Panel, Q::Segment,
+        Q::Cursor, Q::Text, Q::Icon, Q::Separator } );
 }
 
 QskMenuSkinlet::~QskMenuSkinlet() = default;
@@ -51,6 +51,10 @@ QskPushButtonSkinlet::QskPushButtonSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
     setNodeRoles( { PanelRole, SplashRole, IconRole, TextRole } );
+
+    setNodeRoleSubcontrol( PanelRole, QskPushButton::Panel );
+    setNodeRoleSubcontrol( IconRole, QskPushButton::Icon );
+    setNodeRoleSubcontrol( TextRole, QskPushButton::Text );
 }
 
 QskPushButtonSkinlet::~QskPushButtonSkinlet() = default;
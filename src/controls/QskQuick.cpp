@@ -125,6 +125,27 @@ bool qskIsPolishScheduled( const QQuickItem* item )
     return false;
 }
 
+void qskRequestNodeUpdate( QQuickItem* item )
+{
+    if ( item == nullptr )
+        return;
+
+    /*
+        Smooth is one of the bits of QQuickItemPrivate::ContentUpdateMask,
+        that is not set by QQuickItem::update. It has no effect beside
+        calling QQuickItem::updatePaintNode.
+     */
+    QQuickItemPrivate::get( item )->dirty( QQuickItemPrivate::Smooth );
+}
+
+bool qskIsUpdateRequested( const QQuickItem* item )
+{
+    if ( item )
+        return QQuickItemPrivate::get( item )->dirtyAttributes & QQuickItemPrivate::Content;
+
+    return false;
+}
+
 bool qskIsShortcutScope( const QQuickItem* item )
 {
     if ( item == nullptr )
@@ -519,7 +540,12 @@ void qskItemUpdateRecursive( QQuickItem* item )
         return;
 
     if ( item->flags() & QQuickItem::ItemHasContents )
+    {
+        if ( auto control = qskControlCast( item ) )
+            control->setAllSubcontrolsDirty();
+
         item->update();
+    }
 
     const auto& children = QQuickItemPrivate::get( item )->childItems;
     for ( auto child : children )
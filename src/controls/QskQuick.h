@@ -37,6 +37,14 @@ QSK_EXPORT bool qskIsVisibleTo( const QQuickItem* item, const QQuickItem* ancest
 QSK_EXPORT bool qskIsVisibleToParent( const QQuickItem* );
 QSK_EXPORT bool qskIsPolishScheduled( const QQuickItem* );
 
+/*
+    qskRequestNodeUpdate schedules a call of QQuickItem::updatePaintNode
+    without QQuickItem::update, so that qskIsUpdateRequested reports
+    updates, that have been requested by others.
+ */
+QSK_EXPORT void qskRequestNodeUpdate( QQuickItem* );
+QSK_EXPORT bool qskIsUpdateRequested( const QQuickItem* );
+
 QSK_EXPORT bool qskIsVisibleToLayout( const QQuickItem* );
 QSK_EXPORT bool qskIsAdjustableByLayout( const QQuickItem* );
 
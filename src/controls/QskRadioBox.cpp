@@ -7,6 +7,7 @@
 #include "QskEvent.h"
 #include "QskAnimationHint.h"
 #include "QskSkinlet.h"
+#include "QskSkinHintTable.h"
 
 QSK_SUBCONTROL( QskRadioBox, Panel )
 QSK_SUBCONTROL( QskRadioBox, Button )
@@ -107,6 +108,11 @@ int QskRadioBox::pressedIndex() const
     return m_data->pressedIndex;
 }
 
+int QskRadioBox::hoveredIndex() const
+{
+    return m_data->hoveredIndex;
+}
+
 void QskRadioBox::setSelectedIndex( int index )
 {
     if( index == m_data->selectedIndex || index >= m_data->options.count() )
@@ -275,10 +281,21 @@ void QskRadioBox::setHoveredIndex( int index )
     if ( m_data->hoveredIndex == index )
         return;
 
+    // only the nodes of the old/new hovered option need to be updated
+    setSampleDirty( m_data->hoveredIndex );
+    setSampleDirty( index );
+
     m_data->hoveredIndex = index;
-    setPositionHint( CheckIndicator | Hovered, index );
 
-    update();
+    /*
+        The hint is kept for code, that reads the hovered option from
+        positionHint( CheckIndicator | Hovered ). setPositionHint would
+        trigger a full update, so we write it to the local table directly.
+     */
+    auto aspect = CheckIndicator | Hovered | QskAspect::Metric | QskAspect::Position;
+    aspect.setSubcontrol( effectiveSubcontrol( CheckIndicator ) );
+
+    hintTable().setHint( aspect, qreal( index ) );
 }
 
 void QskRadioBox::setFocusedIndex( int index )
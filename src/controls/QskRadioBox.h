@@ -38,6 +38,7 @@ class QSK_EXPORT QskRadioBox : public QskControl
 
     int selectedIndex() const;
     int pressedIndex() const;
+    int hoveredIndex() const;
 
   public Q_SLOTS:
     void setSelectedIndex( int );
@@ -189,7 +189,7 @@ QskAspect::States QskRadioBoxSkinlet::sampleStates(
         states |= Q::Pressed;
 
 #if 1
-    if( radioBox->positionHint( Q::CheckIndicator | Q::Hovered ) == index )
+    if( radioBox->hoveredIndex() == index )
         states |= Q::Hovered;
     else
         states &= ~Q::Hovered;
@@ -59,6 +59,15 @@ QskScrollViewSkinlet::QskScrollViewSkinlet( QskSkin* skin )
     setNodeRoles( { PanelRole, ViewportRole, ContentsRootRole,
         HorizontalScrollBarRole, HorizontalScrollHandleRole,
         VerticalScrollBarRole, VerticalScrollHandleRole } );
+
+    using Q = QskScrollView;
+
+    setNodeRoleSubcontrol( PanelRole, Q::Panel );
+    setNodeRoleSubcontrol( ViewportRole, Q::Viewport );
+    setNodeRoleSubcontrol( HorizontalScrollBarRole, Q::HorizontalScrollBar );
+    setNodeRoleSubcontrol( HorizontalScrollHandleRole, Q::HorizontalScrollHandle );
+    setNodeRoleSubcontrol( VerticalScrollBarRole, Q::VerticalScrollBar );
+    setNodeRoleSubcontrol( VerticalScrollHandleRole, Q::VerticalScrollHandle );
 }
 
 QskScrollViewSkinlet::~QskScrollViewSkinlet() = default;
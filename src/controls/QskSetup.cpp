@@ -17,6 +17,9 @@ namespace
         if ( !qskHasEnvironment( "QSK_PREFER_FBO_PAINTING" ) )
             flags |= QskItem::PreferRasterForTextures;
 
+        if ( qskHasEnvironment( "QSK_ASYNC_TEXTURES" ) )
+            flags |= QskItem::AsynchronousTextures;
+
         if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
             flags |= QskItem::DebugForceBackground;
 
@@ -15,11 +15,18 @@
 #include "QskMargins.h"
 #include "QskFontRole.h"
 
+#include "QskSkinDiff.h"
 #include "QskSkinHintTable.h"
+#include "QskSkinHintProfiler.h"
 #include "QskSkinManager.h"
+#include "QskSkinSnapshot.h"
 #include "QskSkinTransition.h"
 
+#include <qatomic.h>
+#include <qdebug.h>
+#include <qfontmetrics.h>
 #include <qguiapplication.h>
+#include <qscreen.h>
 #include <qpa/qplatformdialoghelper.h>
 #include <qpa/qplatformtheme.h>
 
@@ -106,7 +113,9 @@
 #include "QskStatusIndicator.h"
 #include "QskStatusIndicatorSkinlet.h"
 
+#include <qbitarray.h>
 #include <qhash.h>
+#include <qset.h>
 
 static inline QskSkinlet* qskNewSkinlet( const QMetaObject* metaObject, QskSkin* skin )
 {
@@ -159,21 +168,369 @@ namespace
         const QMetaObject* metaObject;
         QskSkinlet* skinlet; // mutable ???
     };
+
+    class HintCache
+    {
+      public:
+        class Entry
+        {
+          public:
+            QskSkinHintTable::Hint value;
+            QskAspect aspect;
+        };
+
+        QskSkinHintTable::Hint resolvedHint( const QskSkinHintTable& table,
+            QskAspect aspect, QskAspect* resolvedAspect )
+        {
+            if ( generation != table.generation() )
+            {
+                /*
+                    The entries are referring to the values of the table, so
+                    we have to drop all of them whenever the table might
+                    have been modified.
+                 */
+                entries.clear();
+                generation = table.generation();
+            }
+
+            auto it = entries.constFind( aspect );
+            if ( it != entries.constEnd() )
+            {
+                hits++;
+            }
+            else
+            {
+                misses++;
+
+#ifdef QSK_HINT_PROFILER
+                QskSkinHintProfiler::recordCacheMiss( aspect );
+#endif
+                /*
+                    The expanded aspects of the controls in use are limited,
+                    but we don't want to grow without bounds for
+                    applications iterating over all sorts of states.
+                 */
+                if ( entries.size() >= budget )
+                    entries.clear();
+
+                it = entries.insert( aspect, resolve( table, aspect ) );
+            }
+
+            if ( resolvedAspect )
+                *resolvedAspect = it->aspect;
+
+            return it->value;
+        }
+
+        void reset()
+        {
+            entries.clear();
+            generation = 0;
+
+            hits = misses = 0;
+        }
+
+        QHash< QskAspect, Entry > entries;
+        uint generation = 0;
+
+        const int budget = 8192;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+
+      private:
+        static Entry resolve( const QskSkinHintTable& table, QskAspect aspect )
+        {
+            Entry entry;
+
+            if ( table.hasHints() )
+            {
+                entry.value = table.resolvedHint( aspect, &entry.aspect );
+
+                if ( !entry.value && aspect.hasSubcontrol() )
+                {
+                    // trying to resolve something from the skin default settings
+
+                    aspect.clearSubcontrol();
+                    aspect.clearStates();
+
+                    entry.value = table.resolvedHint( aspect, &entry.aspect );
+                }
+            }
+
+            return entry;
+        }
+    };
+
+    class HintsInitializer
+    {
+      public:
+        std::function< void( QskSkinHintTable* ) > initialize;
+        const QMetaObject* metaObject;
+
+        // subcontrols of base classes, that are set by the initializer
+        QVector< QskAspect::Subcontrol > inheritedSubcontrols;
+
+        bool done;
+    };
+
+    class FontCacheEntry
+    {
+      public:
+        FontCacheEntry( const QFont& font = QFont() )
+            : font( font )
+        {
+        }
+
+        void updateMetrics()
+        {
+            if ( !hasMetrics )
+            {
+                const QFontMetricsF fm( font );
+
+                height = fm.height();
+                ascent = fm.ascent();
+                averageCharWidth = fm.averageCharWidth();
+
+                hasMetrics = true;
+            }
+        }
+
+        QFont font;
+
+        qreal height = 0.0;
+        qreal ascent = 0.0;
+        qreal averageCharWidth = 0.0;
+
+        bool hasMetrics = false;
+    };
+}
+
+static inline quint64 qskNextSkinSerialNumber()
+{
+    static QAtomicInteger< quint64 > serialNumber( 0 );
+    return ++serialNumber;
 }
 
 class QskSkin::PrivateData
 {
   public:
+    PrivateData()
+        : serialNumber( qskNextSkinSerialNumber() )
+        , populatedSubcontrols( QskAspect::LastSubcontrol + 1 )
+    {
+    }
+
+    const quint64 serialNumber;
+
+    void populateHints( QskAspect::Subcontrol subControl )
+    {
+        if ( subControl == QskAspect::NoSubcontrol
+            || populatedSubcontrols.testBit( subControl ) )
+        {
+            return;
+        }
+
+        populatedSubcontrols.setBit( subControl );
+
+        populateClassHints( QskAspect::subControlMetaObject( subControl ) );
+
+        /*
+            Initializers of derived classes might set hints for inherited
+            subcontrols - f.e. QskTextField for QskTextInput::Text. Those
+            have been declared together with the initializer and have to run,
+            before the subcontrol is resolved.
+         */
+        const auto it = inheritingInitializers.constFind( subControl );
+        if ( it != inheritingInitializers.constEnd() )
+        {
+            for ( const auto index : it.value() )
+                runInitializer( index );
+        }
+    }
+
+    void scheduleFreeze( QskSkin* skin )
+    {
+        /*
+            Modifying a frozen table unfreezes it. Classes are usually
+            populated in bursts - f.e. when creating the controls of a page.
+            So freezing again is delayed until returning to the event loop,
+            instead of copying the table after each class.
+         */
+        if ( freezeScheduled || hintTable.isFrozen() )
+            return;
+
+        freezeScheduled = true;
+
+        QMetaObject::invokeMethod( skin,
+            [ this ] { freezeScheduled = false; hintTable.freeze(); },
+            Qt::QueuedConnection );
+    }
+
+    void populateClassHints( const QMetaObject* metaObject )
+    {
+        for ( ; metaObject; metaObject = metaObject->superClass() )
+        {
+            if ( populatedClasses.contains( metaObject ) )
+                break; // its base classes have been populated before
+
+            populatedClasses.insert( metaObject );
+
+            const auto it = initializerMap.constFind( metaObject );
+            if ( it != initializerMap.constEnd() )
+            {
+                for ( const auto index : it.value() )
+                    runInitializer( index );
+            }
+        }
+    }
+
+    void populateAllHints()
+    {
+        for ( int i = 0; i < initializers.size(); i++ )
+            runInitializer( i );
+    }
+
+    void runInitializer( int index )
+    {
+        auto& initializer = initializers[ index ];
+        if ( initializer.done )
+            return;
+
+        initializer.done = true;
+        pendingInitializers--;
+
+        QskSkinHintTable table;
+        initializer.initialize( &table );
+
+#ifndef QT_NO_DEBUG
+        checkInheritedSubcontrols( initializer, table );
+#endif
+
+        /*
+            Initializers are running in a different order than they
+            have been declared. To get the same result as when
+            running them all upfront, hints of an initializer can't
+            overwrite those from initializers declared later.
+
+            Hints without origin have been set explicitly - f.e. by a
+            skin subclass or the application after initHints() - and
+            are never overwritten by a deferred initializer.
+         */
+
+        const auto hints = table.hints();
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const auto origin = hintOrigins.constFind( it.key() );
+            if ( origin == hintOrigins.constEnd() )
+            {
+                if ( hintTable.hasHint( it.key() ) )
+                    continue;
+            }
+            else if ( origin.value() > index )
+            {
+                continue;
+            }
+
+            hintOrigins.insert( it.key(), index );
+            hintTable.setHint( it.key(), it.value() );
+        }
+    }
+
+#ifndef QT_NO_DEBUG
+    static void checkInheritedSubcontrols(
+        const HintsInitializer& initializer, const QskSkinHintTable& table )
+    {
+        /*
+            Hints for subcontrols of base classes, that have not been
+            declared, are missing as long as the class of the initializer
+            has not been populated.
+         */
+        QVector< QskAspect::Subcontrol > undeclared;
+
+        const auto hints = table.hints();
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const auto subControl = it.key().subControl();
+            if ( subControl == QskAspect::NoSubcontrol
+                || undeclared.contains( subControl )
+                || initializer.inheritedSubcontrols.contains( subControl ) )
+            {
+                continue;
+            }
+
+            const auto metaObject = QskAspect::subControlMetaObject( subControl );
+            if ( metaObject && metaObject != initializer.metaObject
+                && initializer.metaObject->inherits( metaObject ) )
+            {
+                undeclared += subControl;
+
+                qWarning() << "QskSkin::declareHints:" << subControl
+                    << "is set by the initializer of"
+                    << initializer.metaObject->className()
+                    << "without being declared as inherited subcontrol";
+            }
+        }
+    }
+#endif
+
     QHash< const QMetaObject*, SkinletData > skinletMap;
 
     QskSkinHintTable hintTable;
+    HintCache hintCache;
+
+    QVector< HintsInitializer > initializers;
+    QHash< const QMetaObject*, QVector< int > > initializerMap;
+
+    // initializers of derived classes, indexed by the inherited subcontrol
+    QHash< quint16, QVector< int > > inheritingInitializers;
+    QHash< QskAspect, int > hintOrigins;
+    int pendingInitializers = 0;
+
+    bool freezeScheduled = false;
+
+    /*
+        Remembering the classes, that have been populated, so that
+        their hints can be restored immediately, when the skin is
+        initialized again ( f.e. for a different color scheme ).
+     */
+    QSet< const QMetaObject* > populatedClasses;
+    QBitArray populatedSubcontrols;
+
+    FontCacheEntry& fontCacheEntry( const QskFontRole& fontRole )
+    {
+        auto it = fontCache.find( fontRole );
+        if ( it == fontCache.end() )
+        {
+            it = fontCache.insert( fontRole,
+                FontCacheEntry( qskResolvedFont( fonts, fontRole ) ) );
+        }
+
+        return it.value();
+    }
+
+    FontCacheEntry& fontMetricsEntry( const QskFontRole& fontRole )
+    {
+        auto& entry = fontCacheEntry( fontRole );
+        entry.updateMetrics();
+
+        return entry;
+    }
 
     QHash< QskFontRole, QFont > fonts;
     QHash< int, QskColorFilter > graphicFilters;
 
+    /*
+        The fonts resolved from the font table and their metrics. As all
+        controls are asking for the same few roles over and over we avoid
+        creating QFont/QFontMetricsF objects each time.
+     */
+    QHash< QskFontRole, FontCacheEntry > fontCache;
+
     QskGraphicProviderMap graphicProviders;
 
     int colorScheme = -1; // uninitialized
+    QskSkinDiff colorSchemeChanges;
 };
 
 QskSkin::QskSkin( QObject* parent )
@@ -228,12 +585,44 @@ QskSkin::QskSkin( QObject* parent )
 
     setSkinHint( QskControl::Background | QskAspect::Color,
         QVariant::fromValue( QskGradient() ) );
+
+    if ( qGuiApp )
+    {
+        /*
+            The cached fonts and their metrics depend on the font database,
+            f.e. after adding application fonts, and on the logical DPI.
+         */
+        const auto clearFontCache = [ this ]() { m_data->fontCache.clear(); };
+
+        connect( qGuiApp, &QGuiApplication::fontDatabaseChanged,
+            this, clearFontCache );
+
+        connect( qGuiApp, &QGuiApplication::primaryScreenChanged,
+            this, clearFontCache );
+
+        const auto connectScreen = [ this, clearFontCache ]( const QScreen* screen )
+        {
+            connect( screen, &QScreen::logicalDotsPerInchChanged,
+                this, clearFontCache );
+        };
+
+        const auto screens = QGuiApplication::screens();
+        for ( const auto screen : screens )
+            connectScreen( screen );
+
+        connect( qGuiApp, &QGuiApplication::screenAdded, this, connectScreen );
+    }
 }
 
 QskSkin::~QskSkin()
 {
 }
 
+quint64 QskSkin::serialNumber() const
+{
+    return m_data->serialNumber;
+}
+
 QskSkin::ColorScheme QskSkin::colorScheme() const
 {
     if ( m_data->colorScheme < 0 )
@@ -242,6 +631,30 @@ QskSkin::ColorScheme QskSkin::colorScheme() const
     return static_cast< QskSkin::ColorScheme >( m_data->colorScheme );
 }
 
+static inline bool qskIsPopulatingLazily()
+{
+    /*
+        The initializer of a class must not set hints for subcontrols
+        of classes outside of its hierarchy - what is the case for all
+        skins of QSkinny. For measuring the savings the initializers can be
+        run upfront by setting QSK_EAGER_SKIN_HINTS.
+     */
+    return qEnvironmentVariableIntValue( "QSK_EAGER_SKIN_HINTS" ) <= 0;
+}
+
+static QString qskSnapshotFileName( const QskSkin* skin )
+{
+    static const auto path = QString::fromLocal8Bit(
+        qgetenv( "QSK_SKIN_SNAPSHOT_PATH" ) );
+
+    if ( path.isEmpty() || skin->snapshotVersion().isEmpty() )
+        return QString();
+
+    return QStringLiteral( "%1/%2-%3.qsksnapshot" )
+        .arg( path, QString::fromLatin1( skin->metaObject()->className() ) )
+        .arg( skin->colorScheme() );
+}
+
 void QskSkin::setColorScheme( ColorScheme colorScheme )
 {
     if ( colorScheme == m_data->colorScheme )
@@ -249,34 +662,60 @@ void QskSkin::setColorScheme( ColorScheme colorScheme )
 
     m_data->colorScheme = colorScheme;
 
+    /*
+        Even without animation we need the transition for finding
+        out which controls are affected by the new color scheme.
+     */
+    QskSkinTransition transition;
+    transition.setMask( QskSkinTransition::Color );
+    transition.setSourceSkin( this );
+
+    setupHints();
+
+    transition.setTargetSkin( this );
+    m_data->colorSchemeChanges = transition.changes();
+
     const auto transitionHint = qskSkinManager->transitionHint();
     if ( transitionHint.isValid() )
-    {
-        QskSkinTransition transition;
-        transition.setMask( QskSkinTransition::Color );
-        transition.setSourceSkin( this );
+        transition.run( transitionHint );
 
-        clearHints();
-        initHints();
+    Q_EMIT colorSchemeChanged( colorScheme );
+}
 
-        transition.setTargetSkin( this );
-        transition.run( transitionHint );
-    }
-    else
+void QskSkin::setupHints()
+{
+    clearHints();
+
+    /*
+        Restoring the hints from a snapshot is opt-in, as it is only
+        correct for skins, where initHints() depends on the color scheme only.
+     */
+    const auto fileName = qskSnapshotFileName( this );
+
+    if ( fileName.isEmpty() || !QskSkinSnapshot::read( this, fileName ) )
     {
-        clearHints();
         initHints();
+
+        if ( !fileName.isEmpty() )
+        {
+            // a snapshot has to be complete
+            m_data->populateAllHints();
+
+            QskSkinSnapshot::write( this, fileName );
+        }
     }
 
-    Q_EMIT colorSchemeChanged( colorScheme );
+    m_data->hintTable.freeze();
 }
 
 void QskSkin::setSkinHint( QskAspect aspect, const QVariant& skinHint )
 {
+    // explicit hints are not overwritten by deferred initializers
+    m_data->hintOrigins.remove( aspect );
     m_data->hintTable.setHint( aspect, skinHint );
 }
 
-const QVariant& QskSkin::skinHint( QskAspect aspect ) const
+QVariant QskSkin::skinHint( QskAspect aspect ) const
 {
     return m_data->hintTable.hint( aspect );
 }
@@ -370,21 +809,40 @@ void QskSkin::completeFontTable()
             m_data->fonts[ { category, emphasis } ] = font;
         }
     }
+
+    m_data->fontCache.clear();
 }
 
 void QskSkin::setFont( const QskFontRole& fontRole, const QFont& font )
 {
     m_data->fonts[ fontRole ] = font;
+    m_data->fontCache.clear();
 }
 
 void QskSkin::resetFont( const QskFontRole& fontRole )
 {
     m_data->fonts.remove( fontRole );
+    m_data->fontCache.clear();
 }
 
 QFont QskSkin::font( const QskFontRole& fontRole ) const
 {
-    return qskResolvedFont( m_data->fonts, fontRole );
+    return m_data->fontCacheEntry( fontRole ).font;
+}
+
+qreal QskSkin::fontHeight( const QskFontRole& fontRole ) const
+{
+    return m_data->fontMetricsEntry( fontRole ).height;
+}
+
+qreal QskSkin::fontAscent( const QskFontRole& fontRole ) const
+{
+    return m_data->fontMetricsEntry( fontRole ).ascent;
+}
+
+qreal QskSkin::fontAverageCharWidth( const QskFontRole& fontRole ) const
+{
+    return m_data->fontMetricsEntry( fontRole ).averageCharWidth;
 }
 
 void QskSkin::setGraphicFilter( int graphicRole, const QskColorFilter& colorFilter )
@@ -412,6 +870,64 @@ QskSkinHintTable& QskSkin::hintTable()
     return m_data->hintTable;
 }
 
+void QskSkin::populateHints( QskAspect::Subcontrol subControl )
+{
+    if ( m_data->pendingInitializers > 0 )
+    {
+        const bool isFrozen = m_data->hintTable.isFrozen();
+
+        m_data->populateHints( subControl );
+
+        if ( isFrozen )
+            m_data->scheduleFreeze( this );
+    }
+}
+
+void QskSkin::populateHints( const QMetaObject* metaObject )
+{
+    if ( m_data->pendingInitializers > 0 )
+    {
+        const bool isFrozen = m_data->hintTable.isFrozen();
+
+        m_data->populateClassHints( metaObject );
+
+        if ( isFrozen )
+            m_data->scheduleFreeze( this );
+    }
+}
+
+QList< const QMetaObject* > QskSkin::populatedClasses() const
+{
+    return m_data->populatedClasses.values();
+}
+
+QskSkinHintTable::Hint QskSkin::resolvedHint(
+    QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    /*
+        Resolving a hint might need several lookups, that are memoized
+        for the fully expanded aspect. The cache gets invalidated
+        whenever the generation of the hint table changes.
+     */
+    return m_data->hintCache.resolvedHint(
+        m_data->hintTable, aspect, resolvedAspect );
+}
+
+quint64 QskSkin::hintCacheHits() const
+{
+    return m_data->hintCache.hits;
+}
+
+quint64 QskSkin::hintCacheMisses() const
+{
+    return m_data->hintCache.misses;
+}
+
+void QskSkin::resetHintCache()
+{
+    m_data->hintCache.reset();
+}
+
 const QHash< QskFontRole, QFont >& QskSkin::fontTable() const
 {
     return m_data->fonts;
@@ -422,6 +938,11 @@ const QHash< int, QskColorFilter >& QskSkin::graphicFilters() const
     return m_data->graphicFilters;
 }
 
+const QskSkinDiff& QskSkin::colorSchemeChanges() const
+{
+    return m_data->colorSchemeChanges;
+}
+
 void QskSkin::addGraphicProvider(
     const QString& providerId, QskGraphicProvider* provider )
 {
@@ -438,14 +959,69 @@ bool QskSkin::hasGraphicProvider() const
     return m_data->graphicProviders.size() > 0;
 }
 
+void QskSkin::declareHints( const QMetaObject* metaObject,
+    const std::function< void( QskSkinHintTable* ) >& initializer,
+    const QVector< QskAspect::Subcontrol >& inheritedSubcontrols )
+{
+    if ( !qskIsPopulatingLazily() )
+    {
+        initializer( &m_data->hintTable );
+        return;
+    }
+
+    /*
+        The initializer is deferred until a skinnable of the class, one of
+        its subcontrols or a subcontrol of a base class, is in use for the
+        first time. Classes, that never get instantiated, never get their
+        hints populated.
+     */
+    const int index = m_data->initializers.size();
+
+    m_data->initializers += HintsInitializer
+        { initializer, metaObject, inheritedSubcontrols, false };
+    m_data->initializerMap[ metaObject ] += index;
+    m_data->pendingInitializers++;
+
+    bool isInUse = m_data->populatedClasses.contains( metaObject );
+
+    for ( const auto subControl : inheritedSubcontrols )
+    {
+        m_data->inheritingInitializers[ subControl ] += index;
+
+        if ( m_data->populatedSubcontrols.testBit( subControl ) )
+            isInUse = true;
+    }
+
+    if ( isInUse )
+        m_data->runInitializer( index );
+}
+
 void QskSkin::clearHints()
 {
+    m_data->initializers.clear();
+    m_data->initializerMap.clear();
+    m_data->inheritingInitializers.clear();
+    m_data->hintOrigins.clear();
+    m_data->pendingInitializers = 0;
+
+    /*
+        The initializers of derived classes for inherited subcontrols
+        have to run again, when those are resolved next time.
+     */
+    m_data->populatedSubcontrols.fill( false );
+
     m_data->hintTable.clear();
     m_data->fonts.clear();
+    m_data->fontCache.clear();
     m_data->graphicFilters.clear();
     m_data->graphicProviders.clear();
 }
 
+QByteArray QskSkin::snapshotVersion() const
+{
+    return QByteArray();
+}
+
 QString QskSkin::dialogButtonText( int action ) const
 {
     const auto theme = qskPlatformTheme();
@@ -486,6 +1062,13 @@ const QMetaObject* QskSkin::skinletMetaObject( const QMetaObject* metaObject ) c
 
 QskSkinlet* QskSkin::skinlet( const QMetaObject* metaObject )
 {
+    /*
+        The first skinnable of a class is asking for its skinlet: time to
+        populate the hints for it, including those for subcontrols
+        inherited from its base classes.
+     */
+    populateHints( metaObject );
+
     while ( metaObject )
     {
         auto it = m_data->skinletMap.find( metaObject );
@@ -7,10 +7,13 @@
 #define QSK_SKIN_H
 
 #include "QskAspect.h"
+#include "QskSkinHintTable.h"
 
 #include <qcolor.h>
 #include <qobject.h>
+#include <qvector.h>
 
+#include <functional>
 #include <memory>
 #include <type_traits>
 
@@ -22,10 +25,12 @@ class QskGraphic;
 class QskGraphicProvider;
 class QskFontRole;
 
-class QskSkinHintTable;
+class QskSkinDiff;
 
+class QByteArray;
 class QVariant;
 template< typename Key, typename T > class QHash;
+template< typename T > class QList;
 
 class QSK_EXPORT QskSkin : public QObject
 {
@@ -49,11 +54,17 @@ class QSK_EXPORT QskSkin : public QObject
     QskSkin( QObject* parent = nullptr );
     ~QskSkin() override;
 
+    /*
+        Unique for each skin of the application - unlike its address,
+        that might be reused for a skin, that is created later.
+     */
+    quint64 serialNumber() const;
+
     template< typename Control, typename Skinlet >
     void declareSkinlet();
 
     void setSkinHint( QskAspect, const QVariant& hint );
-    const QVariant& skinHint( QskAspect ) const;
+    QVariant skinHint( QskAspect ) const;
 
     void setGraphicFilter( int graphicRole, const QskColorFilter& );
     void resetGraphicFilter( int graphicRole );
@@ -63,6 +74,11 @@ class QSK_EXPORT QskSkin : public QObject
     void resetFont( const QskFontRole& );
     QFont font( const QskFontRole& ) const;
 
+    // cached metrics of font()
+    qreal fontHeight( const QskFontRole& ) const;
+    qreal fontAscent( const QskFontRole& ) const;
+    qreal fontAverageCharWidth( const QskFontRole& ) const;
+
     void addGraphicProvider( const QString& providerId, QskGraphicProvider* );
     QskGraphicProvider* graphicProvider( const QString& providerId ) const;
     bool hasGraphicProvider() const;
@@ -70,17 +86,51 @@ class QSK_EXPORT QskSkin : public QObject
     virtual const int* dialogButtonLayout( Qt::Orientation ) const;
     virtual QString dialogButtonText( int button ) const;
 
+    /*
+        Identifies the code, that sets up the hints. Snapshots
+        ( see QskSkinSnapshot ) are only restored, when having been
+        written for the same version. Skins have to return a different
+        value, whenever initHints() changes - f.e. a hash of the sources
+        like it is done by the qsk_add_snapshot_version CMake function.
+        The default implementation returns an empty array, what disables
+        snapshots for the skin.
+     */
+    virtual QByteArray snapshotVersion() const;
+
     QskSkinlet* skinlet( const QMetaObject* );
     const QMetaObject* skinletMetaObject( const QMetaObject* ) const;
 
     const QskSkinHintTable& hintTable() const;
     QskSkinHintTable& hintTable();
 
+    /*
+        Runs the deferred initializers for the hints of a subcontrol.
+        resolvedHint() does not modify the hint table and has to
+        be called after populateHints().
+     */
+    void populateHints( QskAspect::Subcontrol );
+
+    // for a skinnable class and its base classes
+    void populateHints( const QMetaObject* );
+
+    // the classes, that have been populated since the skin has been created
+    QList< const QMetaObject* > populatedClasses() const;
+
+    QskSkinHintTable::Hint resolvedHint(
+        QskAspect, QskAspect* resolvedAspect = nullptr ) const;
+
+    quint64 hintCacheHits() const;
+    quint64 hintCacheMisses() const;
+    void resetHintCache();
+
     const QHash< QskFontRole, QFont >& fontTable() const;
     const QHash< int, QskColorFilter >& graphicFilters() const;
 
     ColorScheme colorScheme() const;
 
+    // the modifications caused by the last call of setColorScheme()
+    const QskSkinDiff& colorSchemeChanges() const;
+
   public Q_SLOTS:
     void setColorScheme( ColorScheme );
 
@@ -91,6 +141,15 @@ class QSK_EXPORT QskSkin : public QObject
     void clearHints();
     virtual void initHints() = 0;
 
+    /*
+        The initializer is run, when the class is in use for the first time.
+        Initializers, that also set hints for subcontrols of base classes,
+        have to declare them - f.e. QskTextField for QskTextInput::Text.
+     */
+    void declareHints( const QMetaObject*,
+        const std::function< void( QskSkinHintTable* ) >&,
+        const QVector< QskAspect::Subcontrol >& inheritedSubcontrols = {} );
+
     void setupFontTable( const QString& family, bool italic = false );
     void completeFontTable();
 
@@ -98,6 +157,8 @@ class QSK_EXPORT QskSkin : public QObject
     void declareSkinlet( const QMetaObject* metaObject,
         const QMetaObject* skinletMetaObject );
 
+    void setupHints();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
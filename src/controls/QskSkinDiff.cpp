@@ -0,0 +1,226 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinDiff.h"
+#include "QskSkinHintTable.h"
+#include "QskColorFilter.h"
+#include "QskControl.h"
+
+#include <qfont.h>
+
+// from QskSkin.cpp
+extern QFont qskResolvedFont(
+    const QHash< QskFontRole, QFont >&, const QskFontRole& );
+
+static inline bool qskIsRoleAspect( const QskAspect aspect,
+    const QskAspect::Primitive primitive )
+{
+    return ( aspect.type() == QskAspect::NoType )
+        && ( aspect.primitive() == primitive ) && !aspect.isAnimator();
+}
+
+QskSkinDiff::QskSkinDiff()
+{
+}
+
+void QskSkinDiff::reset()
+{
+    m_aspects.clear();
+    m_fontRoles.clear();
+    m_graphicRoles.clear();
+    m_subControls.clear();
+
+    m_global = false;
+}
+
+void QskSkinDiff::compare(
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2,
+    const QHash< QskFontRole, QFont >& fonts1, const QHash< QskFontRole, QFont >& fonts2,
+    const QHash< int, QskColorFilter >& filters1, const QHash< int, QskColorFilter >& filters2 )
+{
+    reset();
+
+    m_subControls.resize( QskAspect::LastSubcontrol + 1 );
+
+    if ( !table1.isSharedWith( table2 ) )
+    {
+        const auto hints1 = table1.hints();
+        const auto hints2 = table2.hints();
+
+        for ( auto it1 = hints1.constBegin(); it1 != hints1.constEnd(); ++it1 )
+        {
+            const auto it2 = hints2.constFind( it1.key() );
+            if ( ( it2 == hints2.constEnd() ) || ( it2.value() != it1.value() ) )
+                addAspect( it1.key() );
+        }
+
+        for ( auto it2 = hints2.constBegin(); it2 != hints2.constEnd(); ++it2 )
+        {
+            if ( !hints1.contains( it2.key() ) )
+                addAspect( it2.key() );
+        }
+    }
+
+    if ( !fonts1.isSharedWith( fonts2 ) )
+    {
+        if ( qskResolvedFont( fonts1, QskFontRole() )
+            != qskResolvedFont( fonts2, QskFontRole() ) )
+        {
+            /*
+                The default font is the fallback for all roles,
+                that have no font of their own.
+             */
+            m_fontRoles += QskFontRole();
+            m_global = true;
+        }
+
+        for ( int i = 0; i <= QskFontRole::Display; i++ )
+        {
+            for ( int j = 0; j <= QskFontRole::VeryHigh; j++ )
+            {
+                const QskFontRole fontRole(
+                    static_cast< QskFontRole::Category >( i ),
+                    static_cast< QskFontRole::Emphasis >( j )
+                );
+
+                if ( qskResolvedFont( fonts1, fontRole )
+                    != qskResolvedFont( fonts2, fontRole ) )
+                {
+                    m_fontRoles += fontRole;
+                }
+            }
+        }
+    }
+
+    if ( !filters1.isSharedWith( filters2 ) )
+    {
+        for ( auto it = filters1.constBegin(); it != filters1.constEnd(); ++it )
+        {
+            if ( filters2.value( it.key() ) != it.value() )
+                m_graphicRoles += it.key();
+        }
+
+        for ( auto it = filters2.constBegin(); it != filters2.constEnd(); ++it )
+        {
+            if ( !filters1.contains( it.key() ) )
+                m_graphicRoles += it.key();
+        }
+    }
+
+    if ( !( m_fontRoles.isEmpty() && m_graphicRoles.isEmpty() ) )
+    {
+        /*
+            Fonts and graphic filters are assigned indirectly by roles.
+            So we have to find the subcontrols, that refer to the
+            modified roles. Modified role hints have already been found
+            above, so it is sufficient to look at the new table.
+         */
+        const auto hints = table2.hints();
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const auto aspect = it.key();
+
+            if ( isAffectedByRole( aspect, it.value() ) )
+            {
+                const auto subControl = aspect.subControl();
+
+                if ( subControl == QskAspect::NoSubcontrol )
+                    m_global = true;
+                else
+                    m_subControls.setBit( subControl );
+            }
+        }
+    }
+}
+
+void QskSkinDiff::addAspect( const QskAspect aspect )
+{
+    const auto subControl = aspect.subControl();
+
+    m_aspects[ subControl ] += aspect;
+
+    if ( subControl == QskAspect::NoSubcontrol )
+        m_global = true;
+    else
+        m_subControls.setBit( subControl );
+}
+
+bool QskSkinDiff::isAffectedByRole(
+    const QskAspect aspect, const QVariant& value ) const
+{
+    if ( !m_fontRoles.isEmpty() && qskIsRoleAspect( aspect, QskAspect::FontRole ) )
+    {
+        if ( value.canConvert< QskFontRole >() )
+            return m_fontRoles.contains( value.value< QskFontRole >() );
+    }
+
+    if ( !m_graphicRoles.isEmpty() && qskIsRoleAspect( aspect, QskAspect::GraphicRole ) )
+        return m_graphicRoles.contains( value.toInt() );
+
+    return false;
+}
+
+bool QskSkinDiff::isEmpty() const
+{
+    return !m_global && m_aspects.isEmpty()
+        && m_fontRoles.isEmpty() && m_graphicRoles.isEmpty();
+}
+
+QVector< QskAspect > QskSkinDiff::aspects() const
+{
+    QVector< QskAspect > aspects;
+
+    for ( const auto& subControlAspects : m_aspects )
+        aspects += subControlAspects;
+
+    return aspects;
+}
+
+QVector< QskAspect > QskSkinDiff::aspects( const QskAspect::Subcontrol subControl ) const
+{
+    return m_aspects.value( subControl );
+}
+
+bool QskSkinDiff::isAffected( const QskAspect::Subcontrol subControl ) const
+{
+    if ( m_global )
+        return true;
+
+    if ( subControl == QskAspect::NoSubcontrol || subControl >= m_subControls.size() )
+        return false;
+
+    return m_subControls.testBit( subControl );
+}
+
+bool QskSkinDiff::isAffected( const QskControl* control ) const
+{
+    if ( m_global )
+        return true;
+
+    if ( control == nullptr || isEmpty() )
+        return false;
+
+    const auto subControls = control->subControls();
+    for ( const auto subControl : subControls )
+    {
+        if ( isAffected( subControl ) )
+            return true;
+    }
+
+    if ( hasFontChanges() || hasGraphicFilterChanges() )
+    {
+        // roles, that have been assigned locally
+
+        const auto hints = control->hintTable().hints();
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            if ( isAffectedByRole( it.key(), it.value() ) )
+                return true;
+        }
+    }
+
+    return false;
+}
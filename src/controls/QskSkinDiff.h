@@ -0,0 +1,92 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_DIFF_H
+#define QSK_SKIN_DIFF_H
+
+#include "QskAspect.h"
+#include "QskFontRole.h"
+
+#include <qbitarray.h>
+#include <qhash.h>
+#include <qset.h>
+#include <qvector.h>
+
+class QskSkinHintTable;
+class QskColorFilter;
+class QskControl;
+class QFont;
+class QVariant;
+
+/*
+    QskSkinDiff compares the tables of a skin before and after
+    a modification - f.e. switching the color scheme - and finds out
+    which subcontrols are affected.
+
+    Restyling/animating only the controls, that depend on those subcontrols,
+    is significantly cheaper than running over all items, as most of the
+    hints - usually the metrics - do not differ between color schemes.
+ */
+class QSK_EXPORT QskSkinDiff
+{
+  public:
+    QskSkinDiff();
+
+    void compare(
+        const QskSkinHintTable&, const QskSkinHintTable&,
+        const QHash< QskFontRole, QFont >&, const QHash< QskFontRole, QFont >&,
+        const QHash< int, QskColorFilter >&, const QHash< int, QskColorFilter >& );
+
+    void reset();
+
+    bool isEmpty() const;
+
+    /*
+        A global change has an effect on all controls: f.e when a hint
+        for QskAspect::NoSubcontrol or the default font has been modified.
+     */
+    bool isGlobal() const;
+
+    bool hasFontChanges() const;
+    bool hasGraphicFilterChanges() const;
+
+    // all modified aspects, including states/variations/sections
+    QVector< QskAspect > aspects() const;
+    QVector< QskAspect > aspects( QskAspect::Subcontrol ) const;
+
+    bool isAffected( QskAspect::Subcontrol ) const;
+    bool isAffected( const QskControl* ) const;
+
+  private:
+    void addAspect( QskAspect );
+    bool isAffectedByRole( QskAspect, const QVariant& ) const;
+
+    QHash< QskAspect::Subcontrol, QVector< QskAspect > > m_aspects;
+
+    QSet< QskFontRole > m_fontRoles;
+    QSet< int > m_graphicRoles;
+
+    // subcontrols with modified hints or with modified fonts/graphic filters
+    QBitArray m_subControls;
+
+    bool m_global = false;
+};
+
+inline bool QskSkinDiff::isGlobal() const
+{
+    return m_global;
+}
+
+inline bool QskSkinDiff::hasFontChanges() const
+{
+    return !m_fontRoles.isEmpty();
+}
+
+inline bool QskSkinDiff::hasGraphicFilterChanges() const
+{
+    return !m_graphicRoles.isEmpty();
+}
+
+#endif
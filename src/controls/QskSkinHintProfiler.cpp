@@ -0,0 +1,320 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinHintProfiler.h"
+
+#include <qdebug.h>
+#include <qhash.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qquickwindow.h>
+#include <qtextstream.h>
+#include <qvector.h>
+
+#include <algorithm>
+
+extern bool qskHasEnvironment( const char* );
+
+namespace
+{
+    class Profiler
+    {
+      public:
+        Profiler()
+            : enabled( qskHasEnvironment( "QSK_HINT_PROFILER" ) )
+        {
+        }
+
+        QskSkinHintProfiler::Record& record( QskAspect aspect )
+        {
+            /*
+                Lookups and cache misses are accounted to the query,
+                that triggered them.
+             */
+            if ( nesting > 0 )
+                aspect = currentAspect;
+
+            auto& record = records[ aspect ];
+            record.aspect = aspect;
+
+            return record;
+        }
+
+        bool enabled;
+
+        int nesting = 0;
+        QskAspect currentAspect;
+
+        quint64 frameCount = 0;
+        QHash< QskAspect, QskSkinHintProfiler::Record > records;
+    };
+}
+
+Q_GLOBAL_STATIC( Profiler, qskProfiler )
+
+static QString qskAspectString( QskAspect aspect )
+{
+    QString s;
+
+#ifndef QT_NO_DEBUG_STREAM
+    {
+        QDebug debug( &s );
+        debug.nospace();
+        debug.noquote();
+
+        debug << aspect;
+    }
+#else
+    s = QString::number( aspect.value(), 16 );
+#endif
+
+    return s;
+}
+
+static inline qreal qskAverageDepth( const QskSkinHintProfiler::Record& record )
+{
+    if ( record.lookups == 0 )
+        return 0.0;
+
+    return qreal( record.fallbackSteps ) / record.lookups;
+}
+
+bool QskSkinHintProfiler::isAvailable()
+{
+#ifdef QSK_HINT_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+void QskSkinHintProfiler::setEnabled( bool on )
+{
+    if ( on && !isAvailable() )
+    {
+        qWarning( "QskSkinHintProfiler: not compiled in, see ENABLE_HINT_PROFILER" );
+        return;
+    }
+
+    qskProfiler->enabled = on;
+}
+
+bool QskSkinHintProfiler::isEnabled()
+{
+    return isAvailable() && qskProfiler->enabled;
+}
+
+void QskSkinHintProfiler::reset()
+{
+    qskProfiler->records.clear();
+    qskProfiler->frameCount = 0;
+}
+
+void QskSkinHintProfiler::nextFrame()
+{
+    auto profiler = qskProfiler;
+    if ( !profiler->enabled )
+        return;
+
+    for ( auto& record : profiler->records )
+    {
+        record.maxQueriesPerFrame =
+            qMax( record.maxQueriesPerFrame, record.queriesInFrame );
+
+        record.queriesInFrame = 0;
+    }
+
+    profiler->frameCount++;
+}
+
+quint64 QskSkinHintProfiler::frameCount()
+{
+    return qskProfiler->frameCount;
+}
+
+void QskSkinHintProfiler::trackFrames( QQuickWindow* window )
+{
+    if ( window )
+    {
+        QObject::connect( window, &QQuickWindow::frameSwapped,
+            window, &QskSkinHintProfiler::nextFrame, Qt::UniqueConnection );
+    }
+}
+
+QVector< QskSkinHintProfiler::Record > QskSkinHintProfiler::records( SortOrder order )
+{
+    const auto& hash = qskProfiler->records;
+
+    QVector< Record > records;
+    records.reserve( hash.size() );
+
+    for ( const auto& record : hash )
+    {
+        records += record;
+
+        // including the frame, that has not been completed yet
+        auto& r = records.last();
+        r.maxQueriesPerFrame = qMax( r.maxQueriesPerFrame, r.queriesInFrame );
+    }
+
+    bool ( *lessThan )( const Record&, const Record& ) =
+        []( const Record& r1, const Record& r2 ) { return r1.queries > r2.queries; };
+
+    if ( order == ByFallbackSteps )
+    {
+        lessThan = []( const Record& r1, const Record& r2 )
+            { return r1.fallbackSteps > r2.fallbackSteps; };
+    }
+    else if ( order == ByCacheMisses )
+    {
+        lessThan = []( const Record& r1, const Record& r2 )
+            { return r1.cacheMisses > r2.cacheMisses; };
+    }
+
+    std::stable_sort( records.begin(), records.end(), lessThan );
+
+    return records;
+}
+
+QString QskSkinHintProfiler::report( SortOrder order, int maxRecords )
+{
+    auto records = QskSkinHintProfiler::records( order );
+    if ( maxRecords >= 0 && records.size() > maxRecords )
+        records.resize( maxRecords );
+
+    QString s;
+
+    QTextStream out( &s );
+
+    out << "Hint lookups: " << records.size() << " aspects, "
+        << qskProfiler->frameCount << " frames\n";
+
+    out << qSetFieldWidth( 10 ) << "Queries" << "Max/Frame" << "Lookups"
+        << "Avg Depth" << "Max Depth" << "Misses"
+        << "Skinnable" << "Skin" << "Animator" << "None"
+        << qSetFieldWidth( 0 ) << "  Aspect\n";
+
+    for ( const auto& record : std::as_const( records ) )
+    {
+        out << qSetFieldWidth( 10 )
+            << record.queries << record.maxQueriesPerFrame << record.lookups
+            << QString::number( qskAverageDepth( record ), 'f', 2 )
+            << record.maxFallbackDepth << record.cacheMisses
+            << record.sources[ QskSkinHintStatus::Skinnable ]
+            << record.sources[ QskSkinHintStatus::Skin ]
+            << record.sources[ QskSkinHintStatus::Animator ]
+            << record.sources[ QskSkinHintStatus::NoSource ]
+            << qSetFieldWidth( 0 ) << "  " << qskAspectString( record.aspect ) << '\n';
+    }
+
+    out.flush();
+    return s;
+}
+
+QByteArray QskSkinHintProfiler::jsonReport( SortOrder order, int maxRecords )
+{
+    auto records = QskSkinHintProfiler::records( order );
+    if ( maxRecords >= 0 && records.size() > maxRecords )
+        records.resize( maxRecords );
+
+    QJsonArray jsonRecords;
+
+    for ( const auto& record : std::as_const( records ) )
+    {
+        QJsonObject sources;
+        sources[ QStringLiteral( "skinnable" ) ] =
+            double( record.sources[ QskSkinHintStatus::Skinnable ] );
+        sources[ QStringLiteral( "skin" ) ] =
+            double( record.sources[ QskSkinHintStatus::Skin ] );
+        sources[ QStringLiteral( "animator" ) ] =
+            double( record.sources[ QskSkinHintStatus::Animator ] );
+        sources[ QStringLiteral( "none" ) ] =
+            double( record.sources[ QskSkinHintStatus::NoSource ] );
+
+        QJsonObject object;
+        object[ QStringLiteral( "aspect" ) ] = qskAspectString( record.aspect );
+        object[ QStringLiteral( "value" ) ] =
+            QString::number( record.aspect.value(), 16 );
+        object[ QStringLiteral( "queries" ) ] = double( record.queries );
+        object[ QStringLiteral( "maxQueriesPerFrame" ) ] =
+            double( record.maxQueriesPerFrame );
+        object[ QStringLiteral( "lookups" ) ] = double( record.lookups );
+        object[ QStringLiteral( "fallbackSteps" ) ] = double( record.fallbackSteps );
+        object[ QStringLiteral( "maxFallbackDepth" ) ] =
+            double( record.maxFallbackDepth );
+        object[ QStringLiteral( "cacheMisses" ) ] = double( record.cacheMisses );
+        object[ QStringLiteral( "sources" ) ] = sources;
+
+        jsonRecords += object;
+    }
+
+    QJsonObject root;
+    root[ QStringLiteral( "frames" ) ] = double( qskProfiler->frameCount );
+    root[ QStringLiteral( "records" ) ] = jsonRecords;
+
+    return QJsonDocument( root ).toJson();
+}
+
+QskSkinHintProfiler::Query::Query(
+        QskAspect aspect, const QskSkinHintStatus* status )
+    : m_aspect( aspect )
+    , m_status( status )
+    , m_nested( false )
+    , m_active( false )
+{
+    auto profiler = qskProfiler;
+    if ( profiler->enabled )
+    {
+        m_nested = true;
+
+        // only the outermost query is counted
+        m_active = ( profiler->nesting++ == 0 );
+
+        if ( m_active )
+            profiler->currentAspect = aspect;
+    }
+}
+
+QskSkinHintProfiler::Query::~Query()
+{
+    if ( !m_nested )
+        return;
+
+    auto profiler = qskProfiler;
+    profiler->nesting--;
+
+    if ( m_active )
+    {
+        auto& record = profiler->records[ m_aspect ];
+        record.aspect = m_aspect;
+
+        record.queries++;
+        record.queriesInFrame++;
+
+        if ( m_status )
+            record.sources[ m_status->source ]++;
+    }
+}
+
+void QskSkinHintProfiler::recordLookup( QskAspect aspect, int fallbackDepth )
+{
+    auto profiler = qskProfiler;
+    if ( !profiler->enabled )
+        return;
+
+    auto& record = profiler->record( aspect );
+
+    record.lookups++;
+    record.fallbackSteps += fallbackDepth;
+    record.maxFallbackDepth = qMax( record.maxFallbackDepth, quint32( fallbackDepth ) );
+}
+
+void QskSkinHintProfiler::recordCacheMiss( QskAspect aspect )
+{
+    auto profiler = qskProfiler;
+    if ( profiler->enabled )
+        profiler->record( aspect ).cacheMisses++;
+}
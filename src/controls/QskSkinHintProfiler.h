@@ -0,0 +1,99 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_HINT_PROFILER_H
+#define QSK_SKIN_HINT_PROFILER_H
+
+#include "QskAspect.h"
+#include "QskSkinnable.h"
+
+class QQuickWindow;
+class QByteArray;
+class QString;
+
+template< typename T > class QVector;
+
+/*
+    QskSkinHintProfiler collects statistics about the hint lookups
+    of the skinnables. It is intended for finding pathological skin setups:
+    aspects, that are queried very often or need many fallback steps
+    before a hint is found.
+
+    The instrumentation has to be compiled in ( cmake -DENABLE_HINT_PROFILER=ON )
+    and is enabled at runtime by setEnabled() or by setting the environment
+    variable QSK_HINT_PROFILER.
+ */
+class QSK_EXPORT QskSkinHintProfiler
+{
+  public:
+    class Record
+    {
+      public:
+        // the aspect, that has been requested by the skinnable
+        QskAspect aspect;
+
+        quint64 queries = 0;
+        quint32 queriesInFrame = 0;
+        quint32 maxQueriesPerFrame = 0;
+
+        // resolving the hint in a hint table
+        quint64 lookups = 0;
+        quint64 fallbackSteps = 0;
+        quint32 maxFallbackDepth = 0;
+
+        quint64 cacheMisses = 0;
+
+        // indexed by QskSkinHintStatus::Source
+        quint64 sources[ 4 ] = {};
+    };
+
+    enum SortOrder
+    {
+        ByQueries,
+        ByFallbackSteps,
+        ByCacheMisses
+    };
+
+    static bool isAvailable();
+
+    static void setEnabled( bool );
+    static bool isEnabled();
+
+    static void reset();
+
+    static void nextFrame();
+    static quint64 frameCount();
+
+    // calling nextFrame() for each frame of the window
+    static void trackFrames( QQuickWindow* );
+
+    static QVector< Record > records( SortOrder = ByQueries );
+
+    static QString report( SortOrder = ByQueries, int maxRecords = 50 );
+    static QByteArray jsonReport( SortOrder = ByQueries, int maxRecords = -1 );
+
+    // hooks for the lookup code
+
+    class QSK_EXPORT Query
+    {
+      public:
+        Query( QskAspect, const QskSkinHintStatus* );
+        ~Query();
+
+      private:
+        Q_DISABLE_COPY( Query )
+
+        const QskAspect m_aspect;
+        const QskSkinHintStatus* m_status;
+
+        bool m_nested : 1;
+        bool m_active : 1;
+    };
+
+    static void recordLookup( QskAspect, int fallbackDepth );
+    static void recordCacheMiss( QskAspect );
+};
+
+#endif
@@ -5,27 +5,407 @@
 
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
-
+#include "QskArcMetrics.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskFontRole.h"
+#include "QskGradient.h"
+#include "QskGraphic.h"
+#include "QskMargins.h"
+#include "QskShadowMetrics.h"
+#include "QskSkinHintProfiler.h"
+#include "QskTextColors.h"
+#include "QskTextOptions.h"
+
+#include <qatomic.h>
+#include <qcolor.h>
+#include <qglobalstatic.h>
+#include <qmath.h>
+#include <qsize.h>
+#include <qvector.h>
+
+#include <cstring>
 #include <limits>
+#include <vector>
 
-const QVariant QskSkinHintTable::invalidHint;
+static inline uint qskNextGeneration()
+{
+    static QAtomicInteger< uint > generation( 0 );
+    return ++generation;
+}
+
+static inline bool qskUnboxedHint( const QVariant& hint, qreal& metric )
+{
+    switch( hint.userType() )
+    {
+        case QMetaType::Double:
+            metric = *static_cast< const double* >( hint.constData() );
+            break;
+
+        case QMetaType::Float:
+            metric = *static_cast< const float* >( hint.constData() );
+            break;
+
+        case QMetaType::Int:
+            metric = *static_cast< const int* >( hint.constData() );
+            break;
+
+        default:
+        {
+            if ( !hint.canConvert< qreal >() )
+                return false;
+
+            metric = hint.value< qreal >();
+        }
+    }
+
+    return true;
+}
+
+static inline bool qskUnboxedHint( const QVariant& hint, QColor& color )
+{
+    if ( hint.userType() == QMetaType::QColor )
+    {
+        color = *static_cast< const QColor* >( hint.constData() );
+        return true;
+    }
+
+    if ( hint.canConvert< QColor >() )
+    {
+        color = hint.value< QColor >();
+        return true;
+    }
+
+    return false;
+}
+
+static inline bool qskUnboxedHint( const QVariant& hint, int& flag )
+{
+    if ( hint.userType() == QMetaType::Int )
+    {
+        flag = *static_cast< const int* >( hint.constData() );
+        return true;
+    }
+
+    if ( hint.canConvert< int >() )
+    {
+        flag = hint.value< int >();
+        return true;
+    }
+
+    return false;
+}
+
+/*
+    A read only copy of the hints, that is optimized for lookups:
+    open addressing with linear probing, where the keys are stored
+    in one contiguous block and the values in another one.
+
+    Metrics, colors and flags - the vast majority of all hints - are
+    stored unboxed in the slots. Only values of other types are kept
+    as QVariant.
+ */
+class QskSkinHintTable::FlatTable
+{
+  public:
+    FlatTable( const QHash< QskAspect, QVariant >& hints )
+    {
+        // keeping the load factor below 0.75
+        const auto capacity = qNextPowerOfTwo( quint32( hints.size() * 4 / 3 ) );
+
+        m_mask = capacity - 1;
+        m_count = hints.size();
+
+        m_keys.assign( capacity, EmptyKey );
+        m_slots.resize( capacity );
+
+        for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        {
+            const auto key = it.key().value();
+
+            auto index = slot( key );
+            while ( m_keys[ index ] != EmptyKey )
+                index = ( index + 1 ) & m_mask;
+
+            m_keys[ index ] = key;
+            setValue( m_slots[ index ], it.value() );
+        }
+    }
+
+    inline int find( const QskAspect aspect ) const
+    {
+        const auto key = aspect.value();
+
+        for ( auto index = slot( key ); ; index = ( index + 1 ) & m_mask )
+        {
+            const auto k = m_keys[ index ];
+
+            if ( k == key )
+                return static_cast< int >( index );
+
+            if ( k == EmptyKey )
+                return -1;
+        }
+    }
+
+    inline Hint hint( int index ) const
+    {
+        if ( index < 0 )
+            return Hint();
+
+        const auto& slot = m_slots[ index ];
+
+        switch( slot.type )
+        {
+            case Hint::Metric:
+                return Hint( &slot.metric, Hint::Metric );
+
+            case Hint::Color:
+                return Hint( &slot.rgb, Hint::Color );
+
+            case Hint::Flag:
+                return Hint( &slot.flag, Hint::Flag );
+
+            default:
+                return Hint( &m_variants[ slot.index ], Hint::Boxed );
+        }
+    }
+
+    QHash< QskAspect, QVariant > hints() const
+    {
+        /*
+            The hash is only needed for the rare operations, that iterate
+            over all hints - like QskSkinDiff or QskSkinSnapshot. It is
+            not kept, as it would double the memory of the table.
+         */
+        QHash< QskAspect, QVariant > hints;
+        hints.reserve( m_count );
+
+        for ( size_t i = 0; i < m_keys.size(); i++ )
+        {
+            if ( m_keys[ i ] != EmptyKey )
+                hints.insert( aspectOf( m_keys[ i ] ), hint( int( i ) ).value() );
+        }
+
+        return hints;
+    }
+
+  private:
+    class Slot
+    {
+      public:
+        union
+        {
+            double metric;
+            QRgb rgb;
+            int flag;
+            int index; // into m_variants
+        };
+
+        Hint::Type type = Hint::Invalid;
+    };
+
+    void setValue( Slot& slot, const QVariant& value )
+    {
+        /*
+            Only values, that can be restored without losing any
+            information, are stored unboxed.
+         */
+        switch( value.userType() )
+        {
+            case QMetaType::Double:
+            {
+                slot.metric = *static_cast< const double* >( value.constData() );
+                slot.type = Hint::Metric;
+
+                return;
+            }
+            case QMetaType::Int:
+            {
+                slot.flag = *static_cast< const int* >( value.constData() );
+                slot.type = Hint::Flag;
+
+                return;
+            }
+            case QMetaType::QColor:
+            {
+                const auto color = *static_cast< const QColor* >( value.constData() );
+
+                if ( QColor::fromRgba( color.rgba() ) == color )
+                {
+                    slot.rgb = color.rgba();
+                    slot.type = Hint::Color;
+
+                    return;
+                }
+                break;
+            }
+        }
+
+        slot.index = static_cast< int >( m_variants.size() );
+        slot.type = Hint::Boxed;
+
+        m_variants.push_back( value );
+    }
+
+    static inline QskAspect aspectOf( const quint64 key )
+    {
+        static_assert( sizeof( QskAspect ) == sizeof( key ), "QskAspect is not 64 bit" );
+
+        QskAspect aspect;
+        std::memcpy( &aspect, &key, sizeof( key ) );
+
+        return aspect;
+    }
+
+    /*
+        The upper 16 bits of an aspect are reserved and always 0,
+        so we can use a value with these bits being set as marker.
+     */
+    static constexpr quint64 EmptyKey = std::numeric_limits< quint64 >::max();
+
+    inline quint32 slot( quint64 key ) const
+    {
+        // the finalizer of MurmurHash3
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+
+        return static_cast< quint32 >( key ) & m_mask;
+    }
+
+    quint32 m_mask;
+    int m_count;
+
+    std::vector< quint64 > m_keys;
+    std::vector< Slot > m_slots;
+    std::vector< QVariant > m_variants;
+};
+
+static inline QskSkinHintTable::Hint qskFindHint(
+    const QHash< QskAspect, QVariant >& hints, const QskAspect aspect )
+{
+    auto it = hints.constFind( aspect );
+    return ( it != hints.constEnd() ) ? &it.value() : nullptr;
+}
+
+static inline QskSkinHintTable::Hint qskFindHint(
+    const QskSkinHintTable::FlatTable& hints, const QskAspect aspect )
+{
+    return hints.hint( hints.find( aspect ) );
+}
+
+QVariant QskSkinHintTable::Hint::value() const
+{
+    switch( m_type )
+    {
+        case Boxed:
+            return *static_cast< const QVariant* >( m_data );
+
+        case Metric:
+            return QVariant( *static_cast< const double* >( m_data ) );
+
+        case Color:
+            return QVariant::fromValue(
+                QColor::fromRgba( *static_cast< const QRgb* >( m_data ) ) );
+
+        case Flag:
+            return QVariant( *static_cast< const int* >( m_data ) );
+
+        default:
+            return QVariant();
+    }
+}
+
+bool QskSkinHintTable::Hint::typedValue( qreal& metric ) const
+{
+    switch( m_type )
+    {
+        case Metric:
+            metric = *static_cast< const double* >( m_data );
+            return true;
+
+        case Flag:
+            metric = *static_cast< const int* >( m_data );
+            return true;
+
+        case Boxed:
+            return qskUnboxedHint( *static_cast< const QVariant* >( m_data ), metric );
+
+        default:
+            // a color is no metric
+            return false;
+    }
+}
+
+bool QskSkinHintTable::Hint::typedValue( QColor& color ) const
+{
+    switch( m_type )
+    {
+        case Color:
+            color = QColor::fromRgba( *static_cast< const QRgb* >( m_data ) );
+            return true;
+
+        case Boxed:
+            return qskUnboxedHint( *static_cast< const QVariant* >( m_data ), color );
+
+        default:
+            // metrics and flags are no colors
+            return false;
+    }
+}
+
+bool QskSkinHintTable::Hint::typedValue( int& flag ) const
+{
+    switch( m_type )
+    {
+        case Flag:
+            flag = *static_cast< const int* >( m_data );
+            return true;
+
+        case Boxed:
+            return qskUnboxedHint( *static_cast< const QVariant* >( m_data ), flag );
+
+        case Metric:
+            // truncated like QVariant::value< int >()
+            flag = static_cast< int >( *static_cast< const double* >( m_data ) );
+            return true;
+
+        default:
+            // a color is no flag
+            return false;
+    }
+}
 
-inline const QVariant* qskResolvedHint( QskAspect aspect,
-    const QHash< QskAspect, QVariant >& hints, QskAspect* resolvedAspect )
+template< typename Hints >
+static inline QskSkinHintTable::Hint qskResolvedHint( QskAspect aspect,
+    const Hints& hints, QskAspect* resolvedAspect )
 {
     auto a = aspect;
 
+#ifdef QSK_HINT_PROFILER
+    const auto requestedAspect = aspect;
+    int depth = 0;
+#endif
+
     Q_FOREVER
     {
-        auto it = hints.constFind( aspect );
-        if ( it != hints.constEnd() )
+        if ( const auto value = qskFindHint( hints, aspect ) )
         {
             if ( resolvedAspect )
                 *resolvedAspect = aspect;
 
-            return &it.value();
+#ifdef QSK_HINT_PROFILER
+            QskSkinHintProfiler::recordLookup( requestedAspect, depth );
+#endif
+            return value;
         }
 
+#ifdef QSK_HINT_PROFILER
+        depth++;
+#endif
+
 #if 1
         /*
             We intend to remove the obscure mechanism of resolving a hint
@@ -65,16 +445,215 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
             continue;
         }
 
-        return nullptr;
+#ifdef QSK_HINT_PROFILER
+        QskSkinHintProfiler::recordLookup( requestedAspect, depth );
+#endif
+        return QskSkinHintTable::Hint();
     }
 }
 
+namespace
+{
+    /*
+        Controls are often customized in the same way - f.e. all buttons
+        of a list with the same colors. Instead of having a hash for each
+        of them, tables with identical hints share their data.
+
+        The pool holds implicitly shared copies only, so that entries,
+        that are not in use anymore, can be identified by being detached.
+
+        Tables sharing an entry also share its generation, so that
+        data derived from the hints - like the resolved hints of
+        QskSkinnable - can be shared as well.
+     */
+    class HintsPool
+    {
+      public:
+        using Hints = QHash< QskAspect, QVariant >;
+
+        class Entry
+        {
+          public:
+            Hints hints;
+            uint generation;
+        };
+
+        Entry find( const Hints& hints )
+        {
+            const auto key = hashValue( hints );
+
+            auto& bucket = m_buckets[ key ];
+
+            for ( const auto& entry : std::as_const( bucket ) )
+            {
+                if ( entry.hints.isSharedWith( hints ) || entry.hints == hints )
+                    return entry;
+            }
+
+            const Entry entry { hints, qskNextGeneration() };
+            bucket += entry;
+
+            if ( ++m_count > m_purgeCount )
+                purge();
+
+            return entry;
+        }
+
+      private:
+        template< typename T >
+        static inline const T& valueOf( const QVariant& value )
+        {
+            return *static_cast< const T* >( value.constData() );
+        }
+
+        static QskHashValue hashValue( const QVariant& value )
+        {
+            const auto type = value.userType();
+
+            switch( type )
+            {
+                case QMetaType::Bool:
+                    return qHash( valueOf< bool >( value ) );
+
+                case QMetaType::Int:
+                    return qHash( valueOf< int >( value ) );
+
+                case QMetaType::UInt:
+                    return qHash( valueOf< uint >( value ) );
+
+                case QMetaType::Double:
+                    return qHash( valueOf< double >( value ) );
+
+                case QMetaType::Float:
+                    return qHash( valueOf< float >( value ) );
+
+                case QMetaType::QColor:
+                    return qHash( quint64( valueOf< QColor >( value ).rgba64() ) );
+
+                case QMetaType::QSizeF:
+                {
+                    const auto& size = valueOf< QSizeF >( value );
+                    const qreal values[] = { size.width(), size.height() };
+
+                    return qHashBits( values, sizeof( values ) );
+                }
+
+                case QMetaType::QMarginsF:
+                    return hashMargins( valueOf< QMarginsF >( value ) );
+            }
+
+            /*
+                The types, that are commonly used for skin hints. Other
+                types end up in the same bucket and are compared by value.
+             */
+
+            if ( type == qMetaTypeId< QskMargins >() )
+                return hashMargins( valueOf< QskMargins >( value ) );
+
+            if ( type == qMetaTypeId< QskBoxShapeMetrics >() )
+                return valueOf< QskBoxShapeMetrics >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskBoxBorderMetrics >() )
+                return valueOf< QskBoxBorderMetrics >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskBoxBorderColors >() )
+                return valueOf< QskBoxBorderColors >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskGradient >() )
+                return valueOf< QskGradient >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskShadowMetrics >() )
+                return valueOf< QskShadowMetrics >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskArcMetrics >() )
+                return valueOf< QskArcMetrics >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskFontRole >() )
+                return valueOf< QskFontRole >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskTextColors >() )
+                return valueOf< QskTextColors >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskTextOptions >() )
+                return valueOf< QskTextOptions >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskGraphic >() )
+                return valueOf< QskGraphic >( value ).hash( 0 );
+
+            if ( type == qMetaTypeId< QskAnimationHint >() )
+            {
+                const auto& hint = valueOf< QskAnimationHint >( value );
+                return qHash( hint.duration ) ^ qHash( int( hint.type ) );
+            }
+
+            return qHash( type );
+        }
+
+        static QskHashValue hashMargins( const QMarginsF& margins )
+        {
+            const qreal values[] = { margins.left(), margins.top(),
+                margins.right(), margins.bottom() };
+
+            return qHashBits( values, sizeof( values ) );
+        }
+
+        static QskHashValue hashValue( const Hints& hints )
+        {
+            // independent from the order of the hints
+
+            QskHashValue value = hints.size();
+
+            for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+                value += qHash( it.key() ) ^ hashValue( it.value() );
+
+            return value;
+        }
+
+        void purge()
+        {
+            m_count = 0;
+
+            for ( auto it = m_buckets.begin(); it != m_buckets.end(); )
+            {
+                auto& bucket = it.value();
+
+                for ( int i = bucket.size() - 1; i >= 0; i-- )
+                {
+                    if ( bucket[ i ].hints.isDetached() )
+                        bucket.remove( i );
+                }
+
+                if ( bucket.isEmpty() )
+                {
+                    it = m_buckets.erase( it );
+                }
+                else
+                {
+                    m_count += bucket.size();
+                    ++it;
+                }
+            }
+
+            m_purgeCount = qMax( 2 * m_count, 64 );
+        }
+
+        QHash< QskHashValue, QVector< Entry > > m_buckets;
+
+        int m_count = 0;
+        int m_purgeCount = 64;
+    };
+}
+
+Q_GLOBAL_STATIC( HintsPool, qskHintsPool )
+
 QskSkinHintTable::QskSkinHintTable()
+    : m_generation( qskNextGeneration() )
 {
 }
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
-    : m_animatorCount( other.m_animatorCount )
+    : m_generation( qskNextGeneration() )
+    , m_animatorCount( other.m_animatorCount )
     , m_states( other.m_states )
 {
     if ( other.m_hints )
@@ -93,6 +672,9 @@ QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
          */
         m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
     }
+
+    // frozen tables are read only and can be shared
+    m_flatTable = other.m_flatTable;
 }
 
 QskSkinHintTable::~QskSkinHintTable()
@@ -102,6 +684,9 @@ QskSkinHintTable::~QskSkinHintTable()
 
 QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
 {
+    m_flatTable.reset(); // no need to restore the hash
+    invalidate();
+
     m_animatorCount = ( other.m_animatorCount );
     m_states = other.m_states;
 
@@ -111,22 +696,108 @@ QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
     if ( other.m_hints )
         m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
 
+    m_flatTable = other.m_flatTable;
+
     return *this;
 }
 
-const QHash< QskAspect, QVariant >& QskSkinHintTable::hints() const
+const QVariant QskSkinHintTable::invalidHint;
+
+QHash< QskAspect, QVariant > QskSkinHintTable::hints() const
 {
+    if ( m_flatTable )
+        return m_flatTable->hints();
+
     if ( m_hints )
         return *m_hints;
 
-    static QHash< QskAspect, QVariant > dummyHints;
-    return dummyHints;
+    return QHash< QskAspect, QVariant >();
+}
+
+bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+{
+    if ( m_flatTable )
+        return m_flatTable->find( aspect ) >= 0;
+
+    return m_hints && m_hints->contains( aspect );
+}
+
+QVariant QskSkinHintTable::hint( QskAspect aspect ) const
+{
+    /*
+        Frozen tables store most values unboxed, so the value
+        is returned by value and not as reference.
+     */
+    if ( m_flatTable )
+        return qskFindHint( *m_flatTable, aspect ).value();
+
+    if ( m_hints )
+        return m_hints->value( aspect );
+
+    return QVariant();
+}
+
+bool QskSkinHintTable::isSharedWith( const QskSkinHintTable& other ) const
+{
+    if ( m_flatTable || other.m_flatTable )
+        return m_flatTable == other.m_flatTable;
+
+    if ( m_hints && other.m_hints )
+        return m_hints->isSharedWith( *other.m_hints );
+
+    return m_hints == other.m_hints;
 }
 
 #define QSK_ASSERT_COUNTER( x ) Q_ASSERT( x < std::numeric_limits< decltype( x ) >::max() )
 
+void QskSkinHintTable::invalidate()
+{
+    m_generation = qskNextGeneration();
+
+    if ( m_flatTable )
+    {
+        // a table being edited falls back to the hash
+
+        m_hints = new QHash< QskAspect, QVariant >( m_flatTable->hints() );
+        m_flatTable.reset();
+    }
+}
+
+void QskSkinHintTable::freeze()
+{
+    if ( m_flatTable == nullptr && m_hints != nullptr )
+    {
+        m_flatTable = std::make_shared< const FlatTable >( *m_hints );
+
+        delete m_hints;
+        m_hints = nullptr;
+
+        m_generation = qskNextGeneration();
+    }
+}
+
 bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 {
+    if ( m_flatTable )
+    {
+        // no need to unfreeze the table, when nothing changes
+        const auto index = m_flatTable->find( aspect );
+        if ( index >= 0 && m_flatTable->hint( index ).value() == skinHint )
+            return false;
+    }
+    else if ( m_hints )
+    {
+        const auto it = m_hints->constFind( aspect );
+        if ( it != m_hints->constEnd() && it.value() == skinHint )
+            return false;
+    }
+
+    /*
+        The non const access might detach the hash, what makes
+        previously resolved pointers invalid.
+     */
+    invalidate();
+
     if ( m_hints == nullptr )
         m_hints = new QHash< QskAspect, QVariant >();
 
@@ -146,22 +817,20 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
         return true;
     }
 
-    if ( it.value() != skinHint )
-    {
-        it.value() = skinHint;
-        return true;
-    }
-
-    return false;
+    // being different has been checked above
+    it.value() = skinHint;
+    return true;
 }
 
 #undef QSK_ASSERT_COUNTER
 
 bool QskSkinHintTable::removeHint( QskAspect aspect )
 {
-    if ( m_hints == nullptr )
+    if ( !hasHint( aspect ) )
         return false;
 
+    invalidate();
+
     const bool erased = m_hints->remove( aspect );
 
     if ( erased )
@@ -183,8 +852,10 @@ bool QskSkinHintTable::removeHint( QskAspect aspect )
 
 QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 {
-    if ( m_hints )
+    if ( hasHint( aspect ) )
     {
+        invalidate();
+
         auto it = m_hints->find( aspect );
         if ( it != m_hints->end() )
         {
@@ -211,6 +882,9 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 
 void QskSkinHintTable::clear()
 {
+    m_flatTable.reset(); // no need to restore the hash
+    invalidate();
+
     delete m_hints;
     m_hints = nullptr;
 
@@ -218,21 +892,40 @@ void QskSkinHintTable::clear()
     m_states = QskAspect::NoState;
 }
 
-const QVariant* QskSkinHintTable::resolvedHint(
+bool QskSkinHintTable::shareHints()
+{
+    if ( m_hints == nullptr )
+        return false;
+
+    const auto entry = qskHintsPool->find( *m_hints );
+
+    if ( !m_hints->isSharedWith( entry.hints ) )
+    {
+        // pointers to the previous values become invalid
+        *m_hints = entry.hints;
+    }
+
+    m_generation = entry.generation;
+
+    return true;
+}
+
+QskSkinHintTable::Hint QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
+    if ( m_flatTable != nullptr )
+        return qskResolvedHint( aspect & m_states, *m_flatTable, resolvedAspect );
+
     if ( m_hints != nullptr )
         return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
 
-    return nullptr;
+    return Hint();
 }
 
 QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
     QskAspect a;
-
-    if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+    ( void ) resolvedHint( aspect, &a );
 
     return a;
 }
@@ -240,16 +933,18 @@ QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 QskAspect QskSkinHintTable::resolvedAnimator(
     QskAspect aspect, QskAnimationHint& hint ) const
 {
-    if ( m_hints && m_animatorCount > 0 )
+    if ( hasHints() && m_animatorCount > 0 )
     {
         aspect &= m_states;
 
         Q_FOREVER
         {
-            auto it = m_hints->find( aspect );
-            if ( it != m_hints->cend() )
+            const auto value = m_flatTable
+                ? qskFindHint( *m_flatTable, aspect ) : qskFindHint( *m_hints, aspect );
+
+            if ( value )
             {
-                hint = it.value().value< QskAnimationHint >();
+                hint = value.value().value< QskAnimationHint >();
                 return aspect;
             }
 
@@ -11,11 +11,17 @@
 #include <qvariant.h>
 #include <qhash.h>
 
+#include <memory>
+
 class QskAnimationHint;
+class QColor;
 
 class QSK_EXPORT QskSkinHintTable
 {
   public:
+    class Hint;
+    class FlatTable;
+
     QskSkinHintTable();
     QskSkinHintTable( const QskSkinHintTable& );
     ~QskSkinHintTable();
@@ -26,7 +32,7 @@ class QSK_EXPORT QskSkinHintTable
     QskAnimationHint animation( QskAspect ) const;
 
     bool setHint( QskAspect, const QVariant& );
-    const QVariant& hint( QskAspect ) const;
+    QVariant hint( QskAspect ) const;
 
     template< typename T > bool setHint( QskAspect, const T& );
     template< typename T > T hint( QskAspect ) const;
@@ -36,7 +42,7 @@ class QSK_EXPORT QskSkinHintTable
 
     bool hasHint( QskAspect ) const;
 
-    const QHash< QskAspect, QVariant >& hints() const;
+    QHash< QskAspect, QVariant > hints() const;
 
     bool hasAnimators() const;
     bool hasHints() const;
@@ -45,8 +51,24 @@ class QSK_EXPORT QskSkinHintTable
 
     void clear();
 
-    const QVariant* resolvedHint( QskAspect,
-        QskAspect* resolvedAspect = nullptr ) const;
+    /*
+        Sharing the hints with another table of identical content.
+        The hints are implicitly shared and get detached on the next
+        modification. Tables sharing their hints have the same generation.
+     */
+    bool shareHints();
+
+    bool isSharedWith( const QskSkinHintTable& ) const;
+
+    /*
+        Freezing converts the hints into a read only structure, that
+        is optimized for lookups and replaces the hash. Any modification
+        of the table unfreezes it again.
+     */
+    void freeze();
+    bool isFrozen() const;
+
+    Hint resolvedHint( QskAspect, QskAspect* resolvedAspect = nullptr ) const;
 
     QskAspect resolvedAspect( QskAspect ) const;
 
@@ -55,19 +77,88 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    /*
+        The generation is changing whenever the table might have been
+        modified. It can be used to invalidate data, that has been
+        derived from the table - like resolved hints.
+     */
+    uint generation() const;
+
   private:
+    void invalidate();
 
     static const QVariant invalidHint;
 
     QHash< QskAspect, QVariant >* m_hints = nullptr;
+    std::shared_ptr< const FlatTable > m_flatTable;
+
+    uint m_generation = 0;
 
     unsigned short m_animatorCount = 0;
     QskAspect::States m_states;
 };
 
+/*
+    A value of the table, that has been returned from resolvedHint(). It is
+    valid until the table gets modified - see QskSkinHintTable::generation().
+
+    Frozen tables store metrics, colors and flags unboxed, so that the typed
+    accessors don't have to deal with QVariant. The typed accessors fail
+    for values, that can't be converted - f.e. a color requested as metric.
+ */
+class QSK_EXPORT QskSkinHintTable::Hint
+{
+  public:
+    Hint() = default;
+    Hint( const QVariant* );
+
+    explicit operator bool() const;
+
+    QVariant value() const;
+
+    bool typedValue( qreal& ) const;
+    bool typedValue( QColor& ) const;
+    bool typedValue( int& ) const;
+
+  private:
+    friend class QskSkinHintTable::FlatTable;
+
+    enum Type : quint8
+    {
+        Invalid,
+        Boxed,
+
+        Metric,
+        Color,
+        Flag
+    };
+
+    Hint( const void* data, Type type );
+
+    const void* m_data = nullptr;
+    Type m_type = Invalid;
+};
+
+inline QskSkinHintTable::Hint::Hint( const QVariant* value )
+    : m_data( value )
+    , m_type( value ? Boxed : Invalid )
+{
+}
+
+inline QskSkinHintTable::Hint::Hint( const void* data, Type type )
+    : m_data( data )
+    , m_type( type )
+{
+}
+
+inline QskSkinHintTable::Hint::operator bool() const
+{
+    return m_type != Invalid;
+}
+
 inline bool QskSkinHintTable::hasHints() const
 {
-    return m_hints != nullptr;
+    return ( m_hints != nullptr ) || m_flatTable;
 }
 
 inline QskAspect::States QskSkinHintTable::states() const
@@ -75,26 +166,19 @@ inline QskAspect::States QskSkinHintTable::states() const
     return m_states;
 }
 
-inline bool QskSkinHintTable::hasAnimators() const
+inline bool QskSkinHintTable::isFrozen() const
 {
-    return m_animatorCount > 0;
+    return m_flatTable != nullptr;
 }
 
-inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+inline uint QskSkinHintTable::generation() const
 {
-    return m_hints && m_hints->contains( aspect );
+    return m_generation;
 }
 
-inline const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
+inline bool QskSkinHintTable::hasAnimators() const
 {
-    if ( m_hints != nullptr )
-    {
-        auto it = m_hints->constFind( aspect );
-        if ( it != m_hints->constEnd() )
-            return it.value();
-    }
-
-    return invalidHint;
+    return m_animatorCount > 0;
 }
 
 template< typename T >
@@ -44,7 +44,7 @@ class QSK_EXPORT QskSkinHintTableEditor
     template< typename T > void setHint(
         QskAspect, const T&, QskStateCombination = QskStateCombination() );
 
-    const QVariant& hint( QskAspect ) const;
+    QVariant hint( QskAspect ) const;
     template< typename T > T hint( QskAspect ) const;
 
     bool removeHint( QskAspect, QskStateCombination = QskStateCombination() );
@@ -333,7 +333,7 @@ inline T QskSkinHintTableEditor::hint( QskAspect aspect ) const
     return hint( aspect ).value< T >();
 }
 
-inline const QVariant& QskSkinHintTableEditor::hint( QskAspect aspect ) const
+inline QVariant QskSkinHintTableEditor::hint( QskAspect aspect ) const
 {
     return m_table->hint( aspect );
 }
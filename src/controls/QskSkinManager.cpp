@@ -577,6 +577,14 @@ void QskSkinManager::setSkin( QskSkin* skin )
 
     if ( skin && oldSkin && m_data->transitionHint.isValid() )
     {
+        /*
+            The hints of the new skin are populated lazily. To find out
+            the differences we need those of the classes in use.
+         */
+        const auto classes = oldSkin->populatedClasses();
+        for ( const auto metaObject : classes )
+            skin->populateHints( metaObject );
+
         QskSkinTransition transition;
         transition.setSourceSkin( oldSkin );
         transition.setTargetSkin( skin );
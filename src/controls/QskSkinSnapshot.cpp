@@ -0,0 +1,636 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinSnapshot.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
+
+#include "QskAnimationHint.h"
+#include "QskArcMetrics.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskColorFilter.h"
+#include "QskFontRole.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskGraduationMetrics.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+#include "QskMargins.h"
+#include "QskShadowMetrics.h"
+#include "QskStippleMetrics.h"
+#include "QskTextOptions.h"
+
+#include <qbytearray.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qfont.h>
+#include <qhash.h>
+#include <qsavefile.h>
+#include <qvariant.h>
+#include <qvector.h>
+
+#include <cstring>
+#include <type_traits>
+
+/*
+    The snapshot is written with the same stream version as QskGraphicIO,
+    so that QColor/QFont are encoded independent from the Qt version
+    of the application.
+ */
+static const int qskDataStreamVersion = QDataStream::Qt_5_15;
+
+static const char qskSnapshotMagic[] = { 'Q', 'S', 'K', 'S' };
+static const quint32 qskSnapshotFormat = 1;
+
+namespace
+{
+    enum Encoding : quint8
+    {
+        Invalid,
+        Builtin,
+        Enumeration,
+        Custom
+    };
+
+    class Codec
+    {
+      public:
+        int typeId;
+
+        void ( *write )( QDataStream&, const QVariant& );
+        QVariant ( *read )( QDataStream& );
+    };
+}
+
+// raw values
+
+template< typename T >
+static inline void qskWriteValue( QDataStream& s, const T& value )
+{
+    static_assert( std::is_trivially_copyable< T >::value,
+        "Type needs a dedicated snapshot codec" );
+
+    s.writeRawData( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+}
+
+template< typename T >
+static inline void qskReadValue( QDataStream& s, T& value )
+{
+    static_assert( std::is_trivially_copyable< T >::value,
+        "Type needs a dedicated snapshot codec" );
+
+    if ( s.readRawData( reinterpret_cast< char* >( &value ), sizeof( T ) ) != sizeof( T ) )
+        s.setStatus( QDataStream::ReadPastEnd );
+}
+
+// QskGradient
+
+static void qskWriteValue( QDataStream& s, const QskGradient& gradient )
+{
+    s << quint8( gradient.type() )
+        << quint8( gradient.spreadMode() ) << quint8( gradient.stretchMode() );
+
+    switch( gradient.type() )
+    {
+        case QskGradient::Linear:
+            qskWriteValue( s, gradient.linearDirection() );
+            break;
+
+        case QskGradient::Radial:
+            qskWriteValue( s, gradient.radialDirection() );
+            break;
+
+        case QskGradient::Conic:
+            qskWriteValue( s, gradient.conicDirection() );
+            break;
+
+        default:
+            break;
+    }
+
+    const auto& stops = gradient.stops();
+
+    s << quint32( stops.size() );
+    for ( const auto& stop : stops )
+        s << qreal( stop.position() ) << stop.color();
+}
+
+static void qskReadValue( QDataStream& s, QskGradient& gradient )
+{
+    quint8 type, spreadMode, stretchMode;
+    s >> type >> spreadMode >> stretchMode;
+
+    switch( type )
+    {
+        case QskGradient::Linear:
+        {
+            QskLinearDirection direction;
+            qskReadValue( s, direction );
+
+            gradient.setLinearDirection( direction );
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            QskRadialDirection direction;
+            qskReadValue( s, direction );
+
+            gradient.setRadialDirection( direction );
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            QskConicDirection direction;
+            qskReadValue( s, direction );
+
+            gradient.setConicDirection( direction );
+            break;
+        }
+        default:
+            break;
+    }
+
+    quint32 count;
+    s >> count;
+
+    QskGradientStops stops;
+    stops.reserve( count );
+
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qreal position;
+        QColor color;
+
+        s >> position >> color;
+        stops += QskGradientStop( position, color );
+    }
+
+    gradient.setStops( stops );
+    gradient.setSpreadMode( static_cast< QskGradient::SpreadMode >( spreadMode ) );
+    gradient.setStretchMode( static_cast< QskGradient::StretchMode >( stretchMode ) );
+}
+
+// QskBoxBorderColors
+
+static void qskWriteValue( QDataStream& s, const QskBoxBorderColors& colors )
+{
+    qskWriteValue( s, colors.left() );
+    qskWriteValue( s, colors.top() );
+    qskWriteValue( s, colors.right() );
+    qskWriteValue( s, colors.bottom() );
+}
+
+static void qskReadValue( QDataStream& s, QskBoxBorderColors& colors )
+{
+    QskGradient gradients[ 4 ];
+    for ( auto& gradient : gradients )
+        qskReadValue( s, gradient );
+
+    colors.setLeft( gradients[ 0 ] );
+    colors.setTop( gradients[ 1 ] );
+    colors.setRight( gradients[ 2 ] );
+    colors.setBottom( gradients[ 3 ] );
+}
+
+// QskStippleMetrics
+
+static void qskWriteValue( QDataStream& s, const QskStippleMetrics& metrics )
+{
+    s << qreal( metrics.offset() ) << metrics.pattern();
+}
+
+static void qskReadValue( QDataStream& s, QskStippleMetrics& metrics )
+{
+    qreal offset;
+    QVector< qreal > pattern;
+
+    s >> offset >> pattern;
+    metrics = QskStippleMetrics( pattern, offset );
+}
+
+// QskColorFilter
+
+static void qskWriteValue( QDataStream& s, const QskColorFilter& filter )
+{
+    s << quint32( filter.mask() ) << filter.substitutions();
+}
+
+static void qskReadValue( QDataStream& s, QskColorFilter& filter )
+{
+    quint32 mask;
+    QVector< QPair< QRgb, QRgb > > substitutions;
+
+    s >> mask >> substitutions;
+
+    filter = QskColorFilter( mask );
+    for ( const auto& substitution : std::as_const( substitutions ) )
+        filter.addColorSubstitution( substitution.first, substitution.second );
+}
+
+// QskGraphic
+
+static void qskWriteValue( QDataStream& s, const QskGraphic& graphic )
+{
+    QByteArray data;
+    QskGraphicIO::write( graphic, data );
+
+    s << data;
+}
+
+static void qskReadValue( QDataStream& s, QskGraphic& graphic )
+{
+    QByteArray data;
+    s >> data;
+
+    graphic = QskGraphicIO::read( data );
+}
+
+// QVariant
+
+template< typename T >
+static void qskWriteCustom( QDataStream& s, const QVariant& value )
+{
+    qskWriteValue( s, value.value< T >() );
+}
+
+template< typename T >
+static QVariant qskReadCustom( QDataStream& s )
+{
+    T value;
+    qskReadValue( s, value );
+
+    return QVariant::fromValue( value );
+}
+
+template< typename T >
+static inline Codec qskCodec()
+{
+    return { qMetaTypeId< T >(), qskWriteCustom< T >, qskReadCustom< T > };
+}
+
+static const QVector< Codec >& qskCodecs()
+{
+    /*
+        The position in this list is the id, that ends up in the file:
+        new codecs have to be appended and require to bump qskSnapshotFormat.
+     */
+    static const QVector< Codec > codecs =
+    {
+        qskCodec< QskMargins >(),
+        qskCodec< QskBoxShapeMetrics >(),
+        qskCodec< QskBoxBorderMetrics >(),
+        qskCodec< QskShadowMetrics >(),
+        qskCodec< QskArcMetrics >(),
+        qskCodec< QskGraduationMetrics >(),
+        qskCodec< QskTextOptions >(),
+        qskCodec< QskFontRole >(),
+        qskCodec< QskAnimationHint >(),
+        qskCodec< QskGradient >(),
+        qskCodec< QskBoxBorderColors >(),
+        qskCodec< QskStippleMetrics >(),
+        qskCodec< QskColorFilter >(),
+        qskCodec< QskGraphic >()
+    };
+
+    return codecs;
+}
+
+static inline QVariant qskCreateVariant( int typeId, const void* data )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QVariant( QMetaType( typeId ), data );
+#else
+    return QVariant( typeId, data );
+#endif
+}
+
+static inline int qskTypeId( const QByteArray& typeName )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType::fromName( typeName ).id();
+#else
+    return QMetaType::type( typeName.constData() );
+#endif
+}
+
+static bool qskWriteVariant( QDataStream& s, const QVariant& value )
+{
+    const int typeId = value.userType();
+
+    if ( typeId == QMetaType::UnknownType )
+    {
+        s << quint8( Invalid );
+        return true;
+    }
+
+    if ( typeId < QMetaType::User )
+    {
+        s << quint8( Builtin ) << value;
+        return true;
+    }
+
+    const QMetaType metaType( typeId );
+
+    if ( metaType.flags() & QMetaType::IsEnumeration )
+    {
+        /*
+            Enums are identified by name, as their ids depend on the
+            order of registration.
+         */
+        const auto size = metaType.sizeOf();
+
+        s << quint8( Enumeration ) << QByteArray( metaType.name() ) << quint8( size );
+        s.writeRawData( static_cast< const char* >( value.constData() ), size );
+
+        return true;
+    }
+
+    const auto& codecs = qskCodecs();
+    for ( int i = 0; i < codecs.size(); i++ )
+    {
+        if ( codecs[ i ].typeId == typeId )
+        {
+            s << quint8( Custom ) << quint8( i );
+            codecs[ i ].write( s, value );
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static QVariant qskReadVariant( QDataStream& s )
+{
+    quint8 encoding;
+    s >> encoding;
+
+    switch( encoding )
+    {
+        case Invalid:
+            return QVariant();
+
+        case Builtin:
+        {
+            QVariant value;
+            s >> value;
+
+            return value;
+        }
+
+        case Enumeration:
+        {
+            QByteArray typeName;
+            quint8 size;
+
+            s >> typeName >> size;
+
+            const int typeId = qskTypeId( typeName );
+
+            char data[ 8 ];
+            if ( typeId == QMetaType::UnknownType
+                || size > sizeof( data ) || size != QMetaType( typeId ).sizeOf()
+                || s.readRawData( data, size ) != size )
+            {
+                break;
+            }
+
+            return qskCreateVariant( typeId, data );
+        }
+
+        case Custom:
+        {
+            quint8 index;
+            s >> index;
+
+            const auto& codecs = qskCodecs();
+            if ( index < codecs.size() )
+                return codecs[ index ].read( s );
+
+            break;
+        }
+    }
+
+    s.setStatus( QDataStream::ReadCorruptData );
+    return QVariant();
+}
+
+// snapshot
+
+static QByteArray qskSnapshotKey( const QskSkin* skin )
+{
+    QByteArray key( skin->metaObject()->className() );
+
+    key += '/';
+    key += QByteArray::number( skin->colorScheme() );
+    key += '/';
+    key += QByteArray::number( QSK_VERSION );
+    key += '/';
+    key += QByteArrayLiteral( QSK_SNAPSHOT_VERSION ); // see qsk_add_snapshot_version
+    key += '/';
+    key += skin->snapshotVersion();
+    key += '/';
+    key += QByteArray::number( QT_VERSION );
+    key += '/';
+    key += QByteArray::number( int( sizeof( qreal ) ) );
+    key += '/';
+    key += QByteArray::number( Q_BYTE_ORDER );
+
+    return key;
+}
+
+static bool qskWriteSnapshot( const QskSkin* skin, QByteArray& data )
+{
+    QDataStream s( &data, QIODevice::WriteOnly );
+    s.setVersion( qskDataStreamVersion );
+    s.setByteOrder( QDataStream::BigEndian );
+
+    s.writeRawData( qskSnapshotMagic, sizeof( qskSnapshotMagic ) );
+    s << qskSnapshotFormat << qskSnapshotKey( skin );
+
+    const auto hints = skin->hintTable().hints();
+
+    s << quint32( hints.size() );
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+    {
+        qskWriteValue( s, it.key() );
+
+        if ( !qskWriteVariant( s, it.value() ) )
+        {
+            qWarning( "QskSkinSnapshot: no codec for hints of type %s",
+                it.value().typeName() );
+
+            return false;
+        }
+    }
+
+    const auto& fonts = skin->fontTable();
+
+    s << quint32( fonts.size() );
+    for ( auto it = fonts.constBegin(); it != fonts.constEnd(); ++it )
+    {
+        s << quint8( it.key().category() ) << quint8( it.key().emphasis() );
+        s << it.value();
+    }
+
+    const auto& filters = skin->graphicFilters();
+
+    s << quint32( filters.size() );
+    for ( auto it = filters.constBegin(); it != filters.constEnd(); ++it )
+    {
+        s << qint32( it.key() );
+        qskWriteValue( s, it.value() );
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+static bool qskReadSnapshot( QskSkin* skin, const QByteArray& data )
+{
+    QDataStream s( data );
+    s.setVersion( qskDataStreamVersion );
+    s.setByteOrder( QDataStream::BigEndian );
+
+    char magic[ sizeof( qskSnapshotMagic ) ];
+    if ( s.readRawData( magic, sizeof( magic ) ) != sizeof( magic )
+        || std::memcmp( magic, qskSnapshotMagic, sizeof( magic ) ) != 0 )
+    {
+        return false;
+    }
+
+    quint32 format;
+    QByteArray key;
+
+    s >> format >> key;
+
+    if ( format != qskSnapshotFormat || key != qskSnapshotKey( skin ) )
+        return false;
+
+    quint32 count;
+
+    QskSkinHintTable table;
+
+    s >> count;
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        QskAspect aspect;
+        qskReadValue( s, aspect );
+
+        const auto value = qskReadVariant( s );
+        table.setHint( aspect, value );
+    }
+
+    QHash< QskFontRole, QFont > fonts;
+
+    s >> count;
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        quint8 category, emphasis;
+        QFont font;
+
+        s >> category >> emphasis >> font;
+
+        const QskFontRole fontRole(
+            static_cast< QskFontRole::Category >( category ),
+            static_cast< QskFontRole::Emphasis >( emphasis ) );
+
+        fonts.insert( fontRole, font );
+    }
+
+    QHash< int, QskColorFilter > filters;
+
+    s >> count;
+    for ( quint32 i = 0; i < count && s.status() == QDataStream::Ok; i++ )
+    {
+        qint32 graphicRole;
+        QskColorFilter filter;
+
+        s >> graphicRole;
+        qskReadValue( s, filter );
+
+        filters.insert( graphicRole, filter );
+    }
+
+    if ( s.status() != QDataStream::Ok || !s.atEnd() )
+        return false;
+
+    // everything is valid: now we can modify the skin
+
+    skin->hintTable() = table;
+
+    const auto fontRoles = skin->fontTable().keys();
+    for ( const auto& fontRole : fontRoles )
+        skin->resetFont( fontRole );
+
+    for ( auto it = fonts.constBegin(); it != fonts.constEnd(); ++it )
+        skin->setFont( it.key(), it.value() );
+
+    const auto graphicRoles = skin->graphicFilters().keys();
+    for ( const auto graphicRole : graphicRoles )
+        skin->resetGraphicFilter( graphicRole );
+
+    for ( auto it = filters.constBegin(); it != filters.constEnd(); ++it )
+        skin->setGraphicFilter( it.key(), it.value() );
+
+    return true;
+}
+
+bool QskSkinSnapshot::write( const QskSkin* skin, const QString& fileName )
+{
+    if ( skin == nullptr )
+        return false;
+
+    QByteArray data;
+    if ( !qskWriteSnapshot( skin, data ) )
+        return false;
+
+    // QSaveFile: concurrently starting applications never see a partial file
+
+    QSaveFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly ) )
+        return false;
+
+    if ( file.write( data ) != data.size() )
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+bool QskSkinSnapshot::read( QskSkin* skin, const QString& fileName )
+{
+    if ( skin == nullptr )
+        return false;
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    const auto size = file.size();
+    if ( size <= 0 )
+        return false;
+
+    /*
+        Mapping the file avoids copying it into memory. All values are
+        deep copies of the mapped data, so the mapping can be released
+        before returning.
+     */
+    auto mapped = file.map( 0, size );
+    if ( mapped == nullptr )
+        return false;
+
+    const auto data = QByteArray::fromRawData(
+        reinterpret_cast< const char* >( mapped ), static_cast< int >( size ) );
+
+    const bool ok = qskReadSnapshot( skin, data );
+
+    file.unmap( mapped );
+
+    return ok;
+}
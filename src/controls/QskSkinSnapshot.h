@@ -0,0 +1,30 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_SNAPSHOT_H
+#define QSK_SKIN_SNAPSHOT_H
+
+#include "QskGlobal.h"
+
+class QskSkin;
+class QString;
+
+/*
+    A snapshot is a binary dump of what QskSkin::initHints() produces:
+    the hint table, the font table and the graphic filters.
+
+    Restoring a snapshot is significantly faster than running
+    initHints(), but the format is bound to the skin class, its color scheme,
+    QskSkin::snapshotVersion(), the versions of Qt/QSkinny and the
+    architecture of the host. read() refuses files, that do not match
+    and leaves the skin untouched.
+ */
+namespace QskSkinSnapshot
+{
+    QSK_EXPORT bool write( const QskSkin*, const QString& fileName );
+    QSK_EXPORT bool read( QskSkin*, const QString& fileName );
+}
+
+#endif
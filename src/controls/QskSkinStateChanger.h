@@ -19,14 +19,17 @@ class QskSkinStateChanger
     void resetStates();
 
   private:
-    QskSkinnable* m_skinnable;
+    QskAspect::States* m_states = nullptr;
+    int* m_sampleIndex = nullptr;
+
     const QskAspect::States m_oldStates;
 };
 
 inline QskSkinStateChanger::QskSkinStateChanger( const QskSkinnable* skinnable )
-    : m_skinnable( const_cast< QskSkinnable* >( skinnable ) )
-    , m_oldStates( skinnable->skinStates() )
+    : m_oldStates( skinnable->skinStates() )
 {
+    const_cast< QskSkinnable* >( skinnable )->bindSkinStates(
+        m_states, m_sampleIndex );
 }
 
 inline QskSkinStateChanger::~QskSkinStateChanger()
@@ -37,12 +40,17 @@ inline QskSkinStateChanger::~QskSkinStateChanger()
 inline void QskSkinStateChanger::setStates(
     QskAspect::States states, int sampleIndex )
 {
-    m_skinnable->replaceSkinStates( states, sampleIndex );
+    /*
+        Called for each sample of a series: only plain assignments,
+        so that switching between the samples is cheap.
+     */
+    *m_states = states;
+    *m_sampleIndex = sampleIndex;
 }
 
 inline void QskSkinStateChanger::resetStates()
 {
-    m_skinnable->replaceSkinStates( m_oldStates, -1 );
+    setStates( m_oldStates, -1 );
 }
 
 #endif
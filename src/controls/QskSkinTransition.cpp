@@ -13,6 +13,7 @@
 #include "QskSkinHintTable.h"
 #include "QskFontRole.h"
 #include "QskAspect.h"
+#include "QskSkinDiff.h"
 
 #include <qglobalstatic.h>
 #include <qguiapplication.h>
@@ -55,7 +56,7 @@ static QskAspect::State qskSelectedSampleState( const QskControl* control )
 
 static bool qskHasHintTable( const QskSkin* skin, const QskSkinHintTable& hintTable )
 {
-    return skin->hintTable().hints().isSharedWith( hintTable.hints() );
+    return skin->hintTable().isSharedWith( hintTable );
 }
 
 static void qskSendStyleEventRecursive( QQuickItem* item )
@@ -68,47 +69,60 @@ static void qskSendStyleEventRecursive( QQuickItem* item )
         qskSendStyleEventRecursive( child );
 }
 
-static void qskAddCandidates( const QskSkinTransition::Type mask,
-    const QHash< QskAspect, QVariant >& hints, QSet< QskAspect >& candidates )
+static bool qskIsCandidate( const QskSkinTransition::Type mask, const QskAspect aspect )
 {
-    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
-    {
-        const auto aspect = it.key().trunk();
+    if ( aspect.isAnimator() )
+        return false;
 
-        if ( aspect.isAnimator() )
-            continue;
+    switch( aspect.type() )
+    {
+        case QskAspect::NoType:
+        {
+            if ( aspect.primitive() == QskAspect::GraphicRole )
+                return mask & QskSkinTransition::Color;
 
-        bool isCandidate = false;
+            if ( aspect.primitive() == QskAspect::FontRole )
+                return mask & QskSkinTransition::Metric;
 
-        switch( aspect.type() )
+            break;
+        }
+        case QskAspect::Color:
         {
-            case QskAspect::NoType:
-            {
-                if ( aspect.primitive() == QskAspect::GraphicRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Color;
-                }
-                else if ( aspect.primitive() == QskAspect::FontRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Metric;
-                }
-                break;
-            }
-            case QskAspect::Color:
-            {
-                isCandidate = mask & QskSkinTransition::Color;
-                break;
-            }
-            case QskAspect::Metric:
-            {
-                isCandidate = mask & QskSkinTransition::Metric;
-                break;
-            }
+            return mask & QskSkinTransition::Color;
         }
+        case QskAspect::Metric:
+        {
+            return mask & QskSkinTransition::Metric;
+        }
+    }
+
+    return false;
+}
+
+static QHash< QskAspect::Subcontrol, QVector< QskAspect > > qskCandidates(
+    const QskSkinTransition::Type mask, const QskSkinDiff& diff )
+{
+    /*
+        Only the modified aspects are candidates for an animation. They are
+        grouped by subcontrol, so that we do not need to iterate over all
+        of them for each control.
+     */
+    QHash< QskAspect::Subcontrol, QVector< QskAspect > > candidates;
+
+    const auto aspects = diff.aspects();
+    for ( const auto aspect : aspects )
+    {
+        const auto trunk = aspect.trunk();
 
-        if ( isCandidate )
-            candidates += aspect;
+        if ( qskIsCandidate( mask, trunk ) )
+        {
+            auto& subControlCandidates = candidates[ trunk.subControl() ];
+            if ( !subControlCandidates.contains( trunk ) )
+                subControlCandidates += trunk;
+        }
     }
+
+    return candidates;
 }
 
 namespace
@@ -169,13 +183,17 @@ namespace
         void addFontSizeAnimators( const QskAnimationHint&,
             const QHash< QskFontRole, QFont >&, const QHash< QskFontRole, QFont >& );
 
-        void addItemAspects( QQuickItem*,
-            const QskAnimationHint&, const QSet< QskAspect >&,
-            const QskSkinHintTable&, const QskSkinHintTable& );
+        void addItemAspects( QQuickItem*, const QskAnimationHint&,
+            const QHash< QskAspect::Subcontrol, QVector< QskAspect > >&,
+            const QskSkinDiff&, const QskSkinHintTable&, const QskSkinHintTable& );
 
         void update();
+        void sendStyleEvents();
 
       private:
+        void addItemAspectsRecursive( QQuickItem*, const QskAnimationHint&,
+            const QHash< QskAspect::Subcontrol, QVector< QskAspect > >&,
+            const QskSkinDiff&, const QskSkinHintTable&, const QskSkinHintTable& );
 
         bool isControlAffected( const QskControl*,
             const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
@@ -189,6 +207,11 @@ namespace
 
         void storeUpdateInfo( const QskControl*, QskAspect );
 
+        void addHints( const QskControl*,
+            const QVector< QskAspect::Subcontrol >&, const QskAnimationHint&,
+            const QVector< QskAspect >&, const QskSkinHintTable&,
+            const QskSkinHintTable& );
+
         QQuickWindow* m_window;
 
         QHash< QskAspect, HintAnimator > m_animatorMap;
@@ -196,6 +219,10 @@ namespace
         QHash< QskFontRole, QskVariantAnimator > m_fontSizeAnimatorMap;
 
         std::vector< UpdateInfo > m_updateInfos; // vector: for fast iteration
+
+        // the items, that need to be restyled, when the transition is over
+        QVector< QPointer< QskItem > > m_affectedItems;
+        bool m_restyleAll = false;
     };
 
     class ApplicationAnimator : public QObject
@@ -387,52 +414,102 @@ void WindowAnimator::addFontSizeAnimators(
 }
 
 void WindowAnimator::addItemAspects( QQuickItem* item,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
+    const QskAnimationHint& animatorHint,
+    const QHash< QskAspect::Subcontrol, QVector< QskAspect > >& candidates,
+    const QskSkinDiff& diff,
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+{
+    m_restyleAll = diff.isGlobal();
+    addItemAspectsRecursive( item, animatorHint, candidates, diff, table1, table2 );
+}
+
+void WindowAnimator::addItemAspectsRecursive( QQuickItem* item,
+    const QskAnimationHint& animatorHint,
+    const QHash< QskAspect::Subcontrol, QVector< QskAspect > >& candidates,
+    const QskSkinDiff& diff,
     const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
 {
     if ( auto control = qskControlCast( ( const QQuickItem* )item ) )
     {
-        if ( control->isVisible() && control->isInitiallyPainted() &&
+        if ( diff.isAffected( control ) &&
             qskHasHintTable( control->effectiveSkin(), table2 ) )
         {
-            const auto subControls = control->subControls();
+            if ( !m_restyleAll )
+                m_affectedItems += const_cast< QskControl* >( control );
 
-            const auto& localTable = control->hintTable();
-
-            for ( auto aspect : candidates )
+            if ( control->isVisible() && control->isInitiallyPainted() )
             {
-                if ( isControlAffected( control, subControls, aspect ) )
+                const auto subControls = control->subControls();
+
+                addHints( control, subControls, animatorHint,
+                    candidates.value( QskAspect::NoSubcontrol ), table1, table2 );
+
+                for ( const auto subControl : subControls )
                 {
-                    aspect.setVariation( control->effectiveVariation() );
-                    aspect.setStates( control->skinStates() );
-                    aspect.setSection( control->section() );
-
-                    if ( !localTable.resolvedHint( aspect ) )
-                        addHint( control, animatorHint, aspect, table1, table2 );
-
-                    if ( auto state = qskSelectedSampleState( control ) )
-                    {
-                        aspect.addStates( state );
-                        if ( !localTable.resolvedHint( aspect ) )
-                            addHint( control, animatorHint, aspect, table1, table2 );
-                    }
+                    addHints( control, subControls, animatorHint,
+                        candidates.value( subControl ), table1, table2 );
                 }
-            }
 
 #if 1
+                /*
+                    As it is hard to identify which of the affected controls depend
+                    on the animated graphic filters we schedule an initial update
+                    and let the controls do the rest: see QskSkinnable::effectiveGraphicFilter
+                 */
+                item->update();
+#endif
+            }
+        }
+    }
+    else if ( !m_restyleAll )
+    {
+        if ( auto qskItem = qobject_cast< QskItem* >( item ) )
+        {
             /*
-                As it is hard to identify which controls depend on the animated
-                graphic filters we schedule an initial update and let the
-                controls do the rest: see QskSkinnable::effectiveGraphicFilter
+                Items, that are no controls, have no hints we could
+                check against the diff. So they are always restyled.
              */
-            item->update();
-#endif
+            m_affectedItems += qskItem;
         }
     }
 
     const auto children = item->childItems();
     for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, table1, table2 );
+    {
+        addItemAspectsRecursive( child, animatorHint,
+            candidates, diff, table1, table2 );
+    }
+}
+
+void WindowAnimator::addHints( const QskControl* control,
+    const QVector< QskAspect::Subcontrol >& subControls,
+    const QskAnimationHint& animatorHint, const QVector< QskAspect >& candidates,
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+{
+    if ( candidates.isEmpty() )
+        return;
+
+    const auto& localTable = control->hintTable();
+
+    for ( auto aspect : candidates )
+    {
+        if ( isControlAffected( control, subControls, aspect ) )
+        {
+            aspect.setVariation( control->effectiveVariation() );
+            aspect.setStates( control->skinStates() );
+            aspect.setSection( control->section() );
+
+            if ( !localTable.resolvedHint( aspect ) )
+                addHint( control, animatorHint, aspect, table1, table2 );
+
+            if ( auto state = qskSelectedSampleState( control ) )
+            {
+                aspect.addStates( state );
+                if ( !localTable.resolvedHint( aspect ) )
+                    addHint( control, animatorHint, aspect, table1, table2 );
+            }
+        }
+    }
 }
 
 void WindowAnimator::update()
@@ -453,6 +530,26 @@ void WindowAnimator::update()
     }
 }
 
+void WindowAnimator::sendStyleEvents()
+{
+    if ( m_restyleAll )
+    {
+        qskSendStyleEventRecursive( m_window->contentItem() );
+        return;
+    }
+
+    QEvent event( QEvent::StyleChange );
+
+    for ( const auto& item : std::as_const( m_affectedItems ) )
+    {
+        if ( item )
+        {
+            event.setAccepted( true );
+            QCoreApplication::sendEvent( item, &event );
+        }
+    }
+}
+
 void WindowAnimator::addHint( const QskControl* control,
     const QskAnimationHint& animatorHint, QskAspect aspect,
     const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
@@ -485,9 +582,9 @@ void WindowAnimator::addHint( const QskControl* control,
             accecptIdentity = true;
         }
 
-        if ( QskVariantAnimator::maybeInterpolate( *v1, *v2, accecptIdentity ) )
+        if ( QskVariantAnimator::maybeInterpolate( v1.value(), v2.value(), accecptIdentity ) )
         {
-            storeAnimator( control, aspect, *v1, *v2, animatorHint );
+            storeAnimator( control, aspect, v1.value(), v2.value(), animatorHint );
             storeUpdateInfo( control, aspect );
         }
     }
@@ -496,7 +593,7 @@ void WindowAnimator::addHint( const QskControl* control,
         aspect.setVariation( r1.variation() );
         aspect.setStates( r1.states() );
 
-        storeAnimator( control, aspect, *v1, QVariant(), animatorHint );
+        storeAnimator( control, aspect, v1.value(), QVariant(), animatorHint );
         storeUpdateInfo( control, aspect );
     }
     else if ( v2 )
@@ -504,7 +601,7 @@ void WindowAnimator::addHint( const QskControl* control,
         aspect.setVariation( r1.variation() );
         aspect.setStates( r1.states() );
 
-        storeAnimator( control, aspect, QVariant(), *v2, animatorHint );
+        storeAnimator( control, aspect, QVariant(), v2.value(), animatorHint );
         storeUpdateInfo( control, aspect );
     }
 }
@@ -642,6 +739,9 @@ void ApplicationAnimator::cleanup( QQuickWindow* window )
         auto animator = *it;
         if ( animator->window() == window )
         {
+            // let the items know, that we are done
+            animator->sendStyleEvents();
+
             if ( !animator->isRunning() )
             {
                 // The notification might be for other animators
@@ -650,9 +750,6 @@ void ApplicationAnimator::cleanup( QQuickWindow* window )
                 delete animator;
             }
 
-            // let the items know, that we are done
-            qskSendStyleEventRecursive( window->contentItem() );
-
             break;
         }
     }
@@ -671,6 +768,9 @@ class QskSkinTransition::PrivateData
         QHash< QskFontRole, QFont > fontTable;
     } tables[ 2 ];
 
+    QskSkinDiff changes;
+    bool isDirty = true;
+
     Type mask = QskSkinTransition::AllTypes;
 };
 
@@ -700,6 +800,8 @@ void QskSkinTransition::setSourceSkin( const QskSkin* skin )
     tables.hintTable = skin->hintTable();
     tables.graphicFilters = skin->graphicFilters();
     tables.fontTable = skin->fontTable();
+
+    m_data->isDirty = true;
 }
 
 void QskSkinTransition::setTargetSkin( const QskSkin* skin )
@@ -709,6 +811,26 @@ void QskSkinTransition::setTargetSkin( const QskSkin* skin )
     tables.hintTable = skin->hintTable();
     tables.graphicFilters = skin->graphicFilters();
     tables.fontTable = skin->fontTable();
+
+    m_data->isDirty = true;
+}
+
+const QskSkinDiff& QskSkinTransition::changes() const
+{
+    if ( m_data->isDirty )
+    {
+        const auto& tables1 = m_data->tables[ 0 ];
+        const auto& tables2 = m_data->tables[ 1 ];
+
+        m_data->changes.compare(
+            tables1.hintTable, tables2.hintTable,
+            tables1.fontTable, tables2.fontTable,
+            tables1.graphicFilters, tables2.graphicFilters );
+
+        m_data->isDirty = false;
+    }
+
+    return m_data->changes;
 }
 
 void QskSkinTransition::run( const QskAnimationHint& animationHint )
@@ -724,19 +846,21 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
     const auto& fontTable1 = m_data->tables[ 0 ].fontTable;
     const auto& fontTable2 = m_data->tables[ 1 ].fontTable;
 
-    QSet< QskAspect > candidates;
+    if ( ( animationHint.duration <= 0 ) || ( m_data->mask == 0 ) )
+        return;
 
-    if ( ( animationHint.duration > 0 ) && ( m_data->mask != 0 ) )
-    {
-        qskAddCandidates( m_data->mask, table1.hints(), candidates );
-        qskAddCandidates( m_data->mask, table2.hints(), candidates );
-    }
+    const auto& diff = changes();
 
-    if ( !candidates.isEmpty() )
-    {
-        bool doGraphicFilter = m_data->mask & QskSkinTransition::Color;
-        bool doFont = m_data->mask & QskSkinTransition::Metric;
+    const auto candidates = qskCandidates( m_data->mask, diff );
 
+    bool doGraphicFilter = ( m_data->mask & QskSkinTransition::Color )
+        && diff.hasGraphicFilterChanges();
+
+    bool doFont = ( m_data->mask & QskSkinTransition::Metric )
+        && diff.hasFontChanges();
+
+    if ( !candidates.isEmpty() || doGraphicFilter || doFont )
+    {
         const auto windows = qGuiApp->topLevelWindows();
 
         for ( const auto window : windows )
@@ -771,7 +895,7 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
                  */
 
                 animator->addItemAspects( w->contentItem(),
-                    animationHint, candidates, table1, table2 );
+                    animationHint, candidates, diff, table1, table2 );
 
                 qskApplicationAnimator->add( animator );
             }
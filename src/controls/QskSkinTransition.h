@@ -13,6 +13,7 @@ class QskAnimationHint;
 class QskFontRole;
 class QskAspect;
 class QskSkin;
+class QskSkinDiff;
 
 class QQuickWindow;
 class QVariant;
@@ -39,6 +40,9 @@ class QSK_EXPORT QskSkinTransition
     void setMask( Type );
     Type mask() const;
 
+    // the differences between the tables of the source and the target skin
+    const QskSkinDiff& changes() const;
+
     void run( const QskAnimationHint& );
 
     static bool isRunning();
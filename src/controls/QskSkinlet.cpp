@@ -22,6 +22,7 @@
 #include "QskGraphicNode.h"
 #include "QskGraphic.h"
 #include "QskLinesNode.h"
+#include "QskMargins.h"
 #include "QskSGNode.h"
 #include "QskStippleMetrics.h"
 #include "QskTextColors.h"
@@ -29,10 +30,13 @@
 #include "QskTextOptions.h"
 #include "QskSkinStateChanger.h"
 #include "QskTextureRenderer.h"
+#include "QskTreeNode.h"
 #include "QskSetup.h"
 
+#include <qatomic.h>
 #include <qquickwindow.h>
 #include <qsgsimplerectnode.h>
+#include <qvarlengtharray.h>
 
 static inline QRectF qskSceneAlignedRect( const QQuickItem* item, const QRectF& rect )
 {
@@ -125,13 +129,17 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( graphicNode == nullptr )
         graphicNode = new QskGraphicNode();
 
-    const auto flag = QskItem::PreferRasterForTextures;
+    bool useRaster = QskSetup::testUpdateFlag( QskItem::PreferRasterForTextures );
+    bool isAsync = QskSetup::testUpdateFlag( QskItem::AsynchronousTextures );
 
-    bool useRaster = QskSetup::testUpdateFlag( flag );
     if ( auto qItem = qobject_cast< const QskItem* >( item ) )
-        useRaster = qItem->testUpdateFlag( flag );
+    {
+        useRaster = qItem->testUpdateFlag( QskItem::PreferRasterForTextures );
+        isAsync = qItem->testUpdateFlag( QskItem::AsynchronousTextures );
+    }
 
     graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
+    graphicNode->setAsynchronous( isAsync );
 
     graphicNode->setMirrored( mirrored );
 
@@ -181,17 +189,63 @@ static inline QskTextColors qskTextColors(
         storing the colors as seperated hints. TODO ...
      */
 
-    QskSkinHintStatus status;
+    const QskAspect aspects[] =
+    {
+        subControl | QskAspect::Color,
+        subControl | QskAspect::Color | QskAspect::TextColor,
+        subControl | QskAspect::Color | QskAspect::StyleColor,
+        subControl | QskAspect::Color | QskAspect::LinkColor
+    };
+
+    QVariant hints[ 4 ];
+    skinnable->effectiveSkinHints( 4, aspects, hints );
 
-    auto textColor = skinnable->color( subControl, &status );
+    auto textColor = hints[ 0 ].value< QColor >();
 #if 1
-    if ( !status.isValid() )
-        textColor = skinnable->color( subControl | QskAspect::TextColor );
+    if ( !hints[ 0 ].isValid() )
+        textColor = hints[ 1 ].value< QColor >();
 #endif
 
     return QskTextColors( textColor,
-        skinnable->color( subControl | QskAspect::StyleColor ),
-        skinnable->color( subControl | QskAspect::LinkColor ) );
+        hints[ 2 ].value< QColor >(), hints[ 3 ].value< QColor >() );
+}
+
+namespace
+{
+    class ArcHints
+    {
+      public:
+        QskArcMetrics metrics;
+        QskMargins margins;
+
+        qreal borderWidth = 0.0;
+        QColor borderColor;
+    };
+}
+
+static inline ArcHints qskArcHints(
+    const QskSkinnable* skinnable, QskAspect::Subcontrol subControl )
+{
+    const QskAspect aspects[] =
+    {
+        subControl | QskAspect::Metric | QskAspect::Shape,
+        subControl | QskAspect::Metric | QskAspect::Margin,
+        subControl | QskAspect::Metric | QskAspect::Border,
+        subControl | QskAspect::Color | QskAspect::Border
+    };
+
+    QVariant hints[ 4 ];
+    skinnable->effectiveSkinHints( 4, aspects, hints );
+
+    ArcHints arcHints;
+    arcHints.metrics = hints[ 0 ].value< QskArcMetrics >();
+    arcHints.margins = hints[ 1 ].value< QskMargins >();
+    arcHints.borderWidth = hints[ 2 ].value< qreal >();
+
+    if ( arcHints.borderWidth > 0.0 )
+        arcHints.borderColor = hints[ 3 ].value< QColor >();
+
+    return arcHints;
 }
 
 static inline QQuickWindow* qskWindowOfSkinnable( const QskSkinnable* skinnable )
@@ -290,9 +344,28 @@ class QskSkinlet::PrivateData
     QskSkin* skin;
     QVector< quint8 > nodeRoles;
 
+    // indexed by the node role
+    QVector< QVector< QskAspect::Subcontrol > > nodeRoleSubcontrols;
+
     bool ownedBySkinnable : 1;
 };
 
+static QAtomicInteger< quint64 > qskExecutedUpdates;
+static QAtomicInteger< quint64 > qskSkippedUpdates;
+
+static QAtomicInteger< quint64 > qskExecutedSampleUpdates;
+static QAtomicInteger< quint64 > qskSkippedSampleUpdates;
+
+namespace
+{
+    class SeriesNode final : public QSGNode
+    {
+      public:
+        // the node of each sample, nullptr for samples without node
+        QVector< QSGNode* > sampleNodes;
+    };
+}
+
 QskSkinlet::QskSkinlet( QskSkin* skin )
     : m_data( new PrivateData( skin ) )
 {
@@ -332,6 +405,62 @@ const QVector< quint8 >& QskSkinlet::nodeRoles() const
     return m_data->nodeRoles;
 }
 
+void QskSkinlet::setNodeRoleSubcontrol(
+    quint8 nodeRole, QskAspect::Subcontrol subControl )
+{
+    QVector< QskAspect::Subcontrol > subControls;
+    if ( subControl != QskAspect::NoSubcontrol )
+        subControls += subControl;
+
+    setNodeRoleSubcontrols( nodeRole, subControls );
+}
+
+void QskSkinlet::setNodeRoleSubcontrols(
+    quint8 nodeRole, const QVector< QskAspect::Subcontrol >& subControls )
+{
+    auto& roleSubcontrols = m_data->nodeRoleSubcontrols;
+
+    if ( nodeRole >= roleSubcontrols.size() )
+        roleSubcontrols.resize( nodeRole + 1 );
+
+    roleSubcontrols[ nodeRole ] = subControls;
+}
+
+QVector< QskAspect::Subcontrol > QskSkinlet::nodeRoleSubcontrols( quint8 nodeRole ) const
+{
+    return m_data->nodeRoleSubcontrols.value( nodeRole );
+}
+
+static inline bool qskIsNodeRoleDirty( const QskSkinnable* skinnable,
+    const QVector< QskAspect::Subcontrol >& subControls )
+{
+    if ( subControls.isEmpty() )
+        return true;
+
+    // the node might be a series, where single samples need to be updated
+    if ( skinnable->hasDirtySamples() )
+        return true;
+
+    for ( const auto subControl : subControls )
+    {
+        if ( skinnable->isSubcontrolDirty( subControl ) )
+            return true;
+    }
+
+    return false;
+}
+
+QskSkinlet::Statistics QskSkinlet::statistics()
+{
+    Statistics statistics;
+    statistics.executedUpdates = qskExecutedUpdates.loadRelaxed();
+    statistics.skippedUpdates = qskSkippedUpdates.loadRelaxed();
+    statistics.executedSampleUpdates = qskExecutedSampleUpdates.loadRelaxed();
+    statistics.skippedSampleUpdates = qskSkippedSampleUpdates.loadRelaxed();
+
+    return statistics;
+}
+
 void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) const
 {
     using namespace QskSGNode;
@@ -359,10 +488,24 @@ void QskSkinlet::updateNode( QskSkinnable* skinnable, QSGNode* parentNode ) cons
         replaceChildNode( DebugRole, parentNode, oldNode, newNode );
     }
 
+    const QVector< QskAspect::Subcontrol > noSubcontrols;
+    const auto& roleSubcontrols = m_data->nodeRoleSubcontrols;
+
     for ( const auto nodeRole : std::as_const( m_data->nodeRoles ) )
     {
         Q_ASSERT( nodeRole < FirstReservedRole );
 
+        const auto& subControls = ( nodeRole < roleSubcontrols.size() )
+            ? roleSubcontrols[ nodeRole ] : noSubcontrols;
+
+        if ( !qskIsNodeRoleDirty( skinnable, subControls ) )
+        {
+            qskSkippedUpdates.fetchAndAddRelaxed( 1 );
+            continue;
+        }
+
+        qskExecutedUpdates.fetchAndAddRelaxed( 1 );
+
         oldNode = QskSGNode::findChildNode( parentNode, nodeRole );
         newNode = updateSubNode( skinnable, nodeRole, oldNode );
 
@@ -449,21 +592,28 @@ QSGNode* QskSkinlet::updateBoxNode( const QskSkinnable* skinnable,
     QSGNode* node, const QRectF& rect, const QskGradient& fillGradient,
     QskAspect::Subcontrol subControl )
 {
-    const auto margins = skinnable->marginHint( subControl );
-
-    const auto boxRect = rect.marginsRemoved( margins );
+    const QskAspect aspects[] =
+    {
+        subControl | QskAspect::Metric | QskAspect::Margin,
+        subControl | QskAspect::Metric | QskAspect::Shape,
+        subControl | QskAspect::Metric | QskAspect::Border,
+        subControl | QskAspect::Color | QskAspect::Border,
+        subControl | QskAspect::Metric | QskAspect::Shadow,
+        subControl | QskAspect::Color | QskAspect::Shadow
+    };
+
+    QVariant hints[ 6 ];
+    skinnable->effectiveSkinHints( 6, aspects, hints );
+
+    const auto boxRect = rect.marginsRemoved( hints[ 0 ].value< QskMargins >() );
     if ( boxRect.isEmpty() )
         return nullptr;
 
-    const auto borderMetrics = skinnable->boxBorderMetricsHint( subControl );
-    const auto borderColors = skinnable->boxBorderColorsHint( subControl );
-    const auto shape = skinnable->boxShapeHint( subControl );
-    const auto shadowMetrics = skinnable->shadowMetricsHint( subControl );
-    const auto shadowColor = skinnable->shadowColorHint( subControl );
-
-    return qskUpdateBoxNode( skinnable, node,
-        boxRect, shape, borderMetrics, borderColors, fillGradient,
-        shadowMetrics, shadowColor );
+    return qskUpdateBoxNode( skinnable, node, boxRect,
+        hints[ 1 ].value< QskBoxShapeMetrics >(),
+        hints[ 2 ].value< QskBoxBorderMetrics >(),
+        hints[ 3 ].value< QskBoxBorderColors >(), fillGradient,
+        hints[ 4 ].value< QskShadowMetrics >(), hints[ 5 ].value< QColor >() );
 }
 
 QSGNode* QskSkinlet::updateBoxNode(
@@ -541,17 +691,11 @@ QSGNode* QskSkinlet::updateArcNode( const QskSkinnable* skinnable,
     QSGNode* node, const QRectF& rect, const QskGradient& fillGradient,
     QskAspect::Subcontrol subControl )
 {
-    const auto metrics = skinnable->arcMetricsHint( subControl );
-    const auto r = rect.marginsRemoved( skinnable->marginHint( subControl ) );
-
-    const qreal borderWidth = skinnable->metric( subControl | QskAspect::Border );
-
-    QColor borderColor;
-    if ( borderWidth > 0.0 )
-        borderColor = skinnable->color( subControl | QskAspect::Border );
+    const auto hints = qskArcHints( skinnable, subControl );
+    const auto r = rect.marginsRemoved( hints.margins );
 
     return qskUpdateArcNode( skinnable, node,
-        r, borderWidth, borderColor, fillGradient, metrics );
+        r, hints.borderWidth, hints.borderColor, fillGradient, hints.metrics );
 }
 
 QSGNode* QskSkinlet::updateArcNode(
@@ -586,19 +730,13 @@ QSGNode* QskSkinlet::updateArcNode( const QskSkinnable* skinnable,
     QSGNode* node, const QRectF& rect, const QskGradient& fillGradient,
     qreal startAngle, qreal spanAngle, QskAspect::Subcontrol subControl )
 {
-    auto arcMetrics = skinnable->arcMetricsHint( subControl );
-    arcMetrics.setStartAngle( startAngle );
-    arcMetrics.setSpanAngle( spanAngle );
-
-    const qreal borderWidth = skinnable->metric( subControl | QskAspect::Border );
-
-    QColor borderColor;
-    if ( borderWidth > 0.0 )
-        borderColor = skinnable->color( subControl | QskAspect::Border );
+    auto hints = qskArcHints( skinnable, subControl );
+    hints.metrics.setStartAngle( startAngle );
+    hints.metrics.setSpanAngle( spanAngle );
 
-    const auto r = rect.marginsRemoved( skinnable->marginHint( subControl ) );
+    const auto r = rect.marginsRemoved( hints.margins );
     return updateArcNode( skinnable, node, r,
-        borderWidth, borderColor, fillGradient, arcMetrics );
+        hints.borderWidth, hints.borderColor, fillGradient, hints.metrics );
 }
 
 QSGNode* QskSkinlet::updateLineNode( const QskSkinnable* skinnable,
@@ -786,24 +924,96 @@ int QskSkinlet::sampleIndexAt( const QskSkinnable* skinnable,
 QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
     QskAspect::Subcontrol subControl, QSGNode* rootNode ) const
 {
-    auto node = rootNode ? rootNode->firstChild() : nullptr;
-    QSGNode* lastNode = nullptr;
-
     const auto count = sampleCount( skinnable, subControl );
 
-    for( int i = 0; i < count; i++ )
+    auto seriesNode = dynamic_cast< SeriesNode* >( rootNode );
+
+    const bool isIncremental = seriesNode
+        && ( seriesNode->sampleNodes.count() == count )
+        && !skinnable->isSubcontrolDirty( subControl );
+
+    /*
+        The states of the samples have to be calculated from the states
+        of the skinnable. So we do this upfront, instead of switching
+        the states back and forth for each sample.
+     */
+    QVarLengthArray< QskAspect::States, 32 > states( count );
+    QVarLengthArray< bool, 32 > dirty( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        dirty[ i ] = !isIncremental || skinnable->isSampleDirty( subControl, i );
+
+        if ( dirty[ i ] )
+        {
+            states[ i ] = sampleStates( skinnable, subControl, i );
+            qskExecutedSampleUpdates.fetchAndAddRelaxed( 1 );
+        }
+        else
+        {
+            qskSkippedSampleUpdates.fetchAndAddRelaxed( 1 );
+        }
+    }
+
+    QskSkinStateChanger stateChanger( skinnable );
+
+    if ( isIncremental )
     {
-        QSGNode* newNode = nullptr;
+        // samples, that have not been modified, keep their nodes
 
+        auto& sampleNodes = seriesNode->sampleNodes;
+
+        for ( int i = 0; i < count; i++ )
         {
-            const auto newStates = sampleStates( skinnable, subControl, i );
+            if ( !dirty[ i ] )
+                continue;
+
+            stateChanger.setStates( states[ i ], i );
+
+            const auto oldNode = sampleNodes[ i ];
+            const auto newNode = updateSampleNode( skinnable, subControl, i, oldNode );
 
-            QskSkinStateChanger stateChanger( skinnable );
-            stateChanger.setStates( newStates, i );
+            if ( newNode == oldNode )
+                continue;
 
-            newNode = updateSampleNode( skinnable, subControl, i, node );
+            if ( newNode )
+            {
+                QSGNode* precedingNode = nullptr;
+
+                for ( int j = i - 1; j >= 0 && precedingNode == nullptr; j-- )
+                    precedingNode = sampleNodes[ j ];
+
+                if ( precedingNode )
+                    seriesNode->insertChildNodeAfter( newNode, precedingNode );
+                else
+                    seriesNode->prependChildNode( newNode );
+            }
+
+            if ( oldNode )
+            {
+                seriesNode->removeChildNode( oldNode );
+                if ( oldNode->flags() & QSGNode::OwnedByParent )
+                    delete oldNode;
+            }
+
+            sampleNodes[ i ] = newNode;
         }
 
+        return seriesNode;
+    }
+
+    if ( seriesNode )
+        seriesNode->sampleNodes.fill( nullptr, count );
+
+    auto node = rootNode ? rootNode->firstChild() : nullptr;
+    QSGNode* lastNode = nullptr;
+
+    for( int i = 0; i < count; i++ )
+    {
+        stateChanger.setStates( states[ i ], i );
+
+        auto newNode = updateSampleNode( skinnable, subControl, i, node );
+
         if ( newNode )
         {
             if ( newNode == node )
@@ -813,7 +1023,10 @@ QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
             else
             {
                 if ( rootNode == nullptr )
-                    rootNode = new QSGNode();
+                {
+                    rootNode = seriesNode = new SeriesNode();
+                    seriesNode->sampleNodes.fill( nullptr, count );
+                }
 
                 if ( node )
                     rootNode->insertChildNodeBefore( newNode, node );
@@ -822,10 +1035,16 @@ QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
             }
 
             lastNode = newNode;
+
+            if ( seriesNode )
+                seriesNode->sampleNodes[ i ] = newNode;
         }
     }
 
-    QskSGNode::removeAllChildNodesAfter( rootNode, lastNode );
+    if ( lastNode )
+        QskSGNode::removeAllChildNodesAfter( rootNode, lastNode );
+    else if ( rootNode )
+        QskSGNode::removeAllChildNodesFrom( rootNode, rootNode->firstChild() );
 
     return rootNode;
 }
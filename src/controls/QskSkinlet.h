@@ -68,6 +68,21 @@ class QSK_EXPORT QskSkinlet
 
     const QVector< quint8 >& nodeRoles() const;
 
+    QVector< QskAspect::Subcontrol > nodeRoleSubcontrols( quint8 nodeRole ) const;
+
+    class Statistics
+    {
+      public:
+        quint64 executedUpdates = 0;
+        quint64 skippedUpdates = 0;
+
+        quint64 executedSampleUpdates = 0;
+        quint64 skippedSampleUpdates = 0;
+    };
+
+    // counters for the updates in updateNode and updateSeriesNode
+    static Statistics statistics();
+
     void setOwnedBySkinnable( bool on );
     bool isOwnedBySkinnable() const;
 
@@ -141,6 +156,16 @@ class QSK_EXPORT QskSkinlet
     void setNodeRoles( const QVector< quint8 >& );
     void appendNodeRoles( const QVector< quint8 >& );
 
+    /*
+        Declaring, that the node of a role depends on the hints
+        of specific subcontrols only. Then updating the node can be skipped,
+        when only hints of other subcontrols have been modified.
+        Roles without subcontrols are always updated.
+     */
+    void setNodeRoleSubcontrol( quint8 nodeRole, QskAspect::Subcontrol );
+    void setNodeRoleSubcontrols( quint8 nodeRole,
+        const QVector< QskAspect::Subcontrol >& );
+
     virtual QSGNode* updateSubNode( const QskSkinnable*,
         quint8 nodeRole, QSGNode* ) const;
 
@@ -173,6 +198,10 @@ class QSK_EXPORT QskSkinlet
         const QskGraphic&, QskAspect::Subcontrol,
         Qt::Orientations mirrored = Qt::Orientations() ) const;
 
+    /*
+        Samples, that are not dirty ( see QskSkinnable::isSampleDirty )
+        keep their nodes from the previous update
+     */
     QSGNode* updateSeriesNode( const QskSkinnable*,
         QskAspect::Subcontrol, QSGNode* ) const;
 
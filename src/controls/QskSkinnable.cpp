@@ -12,11 +12,14 @@
 #include "QskControl.h"
 #include "QskHintAnimator.h"
 #include "QskMargins.h"
+#include "QskQuick.h"
 #include "QskSkinManager.h"
 #include "QskSkin.h"
 #include "QskSkinHintTable.h"
+#include "QskSkinHintProfiler.h"
 #include "QskSkinTransition.h"
 #include "QskSkinlet.h"
+#include "QskSyncQueue.h"
 #include "QskWindow.h"
 
 #include "QskBoxShapeMetrics.h"
@@ -32,6 +35,8 @@
 
 #include <qfont.h>
 #include <qfontmetrics.h>
+#include <qhash.h>
+#include <qmutex.h>
 #include <map>
 
 #define DEBUG_MAP 0
@@ -49,12 +54,6 @@ static inline bool qskSetFlag( QskSkinnable* skinnable,
     return skinnable->setSkinHint( aspect, QVariant( flag ) );
 }
 
-static inline int qskFlag( const QskSkinnable* skinnable,
-    const QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint( aspect, status ).toInt();
-}
-
 static inline bool qskSetMetric( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& metric )
 {
@@ -133,8 +132,10 @@ static inline constexpr QskAspect qskAnimatorAspect( const QskAspect aspect )
     return aspect.type() | aspect.subControl() | aspect.primitive();
 }
 
-static inline void qskTriggerUpdates( QskAspect aspect, QQuickItem* item )
+static inline void qskTriggerUpdates( QskAspect aspect, QskSkinnable* skinnable )
 {
+    auto item = skinnable->owningItem();
+
     /*
         To put the hint into effect we have to call the usual suspects:
 
@@ -152,7 +153,19 @@ static inline void qskTriggerUpdates( QskAspect aspect, QQuickItem* item )
     if ( item == nullptr || aspect.isAnimator() )
         return;
 
-    item->update(); // always
+    /*
+        Modified colors have no effect on the layout, so only the
+        nodes of the subcontrol need to be updated
+     */
+    if ( aspect.isColor() )
+    {
+        skinnable->setSubcontrolDirty( aspect.subControl() );
+    }
+    else
+    {
+        skinnable->setAllSubcontrolsDirty();
+        item->update();
+    }
 
     auto control = qskControlCast( item );
     if ( control == nullptr )
@@ -232,6 +245,287 @@ static inline QskAspect qskSubstitutedAspect(
     return aspect;
 }
 
+namespace
+{
+    /*
+        Resolving the hints of a skinnable with local hints needs lookups
+        in the local and in the skin table. The result is memoized for the
+        fully expanded aspect.
+
+        The entries are identified by the generation of the local table.
+        Tables, that share their hints ( see QskSkinHintTable::shareHints ),
+        also share the generation and therefore the entries - f.e. the
+        buttons of a list, that have been customized in the same way.
+        Generations and the serial numbers of the skins are never reused,
+        so entries of tables or skins, that have been modified or deleted,
+        can't be found anymore and are dropped, when the cache exceeds
+        its budget.
+
+        Skinnables without local hints rely on the cache of the skin only:
+        see QskSkin::resolvedHint.
+     */
+    class LocalHintCache
+    {
+      public:
+        class Entry
+        {
+          public:
+            QskSkinHintTable::Hint value;
+            QskAspect aspect;
+            QskSkinHintStatus::Source source = QskSkinHintStatus::NoSource;
+
+            uint skinGeneration = 0;
+        };
+
+        const Entry& entry( const QskSkinHintTable& localTable,
+            const QskSkin* skin, QskAspect aspect )
+        {
+            const Key key { localTable.generation(), skin->serialNumber(), aspect };
+            const auto skinGeneration = skin->hintTable().generation();
+
+            auto it = m_entries.find( key );
+            if ( it == m_entries.end() )
+            {
+#ifdef QSK_HINT_PROFILER
+                QskSkinHintProfiler::recordCacheMiss( aspect );
+#endif
+                if ( m_entries.size() >= m_budget )
+                    m_entries.clear();
+
+                it = m_entries.insert( key, resolve( localTable, skin, aspect ) );
+            }
+            else if ( it->skinGeneration != skinGeneration )
+            {
+                // the entry is referring to the values of a modified skin table
+                *it = resolve( localTable, skin, aspect );
+            }
+
+            return it.value();
+        }
+
+      private:
+        class Key
+        {
+          public:
+            inline bool operator==( const Key& other ) const noexcept
+            {
+                return ( localGeneration == other.localGeneration )
+                    && ( skinSerialNumber == other.skinSerialNumber )
+                    && ( aspect == other.aspect );
+            }
+
+            uint localGeneration;
+            quint64 skinSerialNumber;
+            QskAspect aspect;
+        };
+
+        friend inline QskHashValue qHash(
+            const Key& key, QskHashValue seed = 0 ) noexcept
+        {
+            seed = qHash( key.localGeneration, seed );
+            seed = qHash( key.skinSerialNumber, seed );
+
+            return qHash( key.aspect, seed );
+        }
+
+        static Entry resolve( const QskSkinHintTable& localTable,
+            const QskSkin* skin, QskAspect aspect )
+        {
+            Entry entry;
+            entry.skinGeneration = skin->hintTable().generation();
+
+            entry.value = localTable.resolvedHint( aspect, &entry.aspect );
+            if ( entry.value )
+            {
+                entry.source = QskSkinHintStatus::Skinnable;
+                return entry;
+            }
+
+            entry.value = skin->resolvedHint( aspect, &entry.aspect );
+            if ( entry.value )
+            {
+                entry.source = QskSkinHintStatus::Skin;
+                return entry;
+            }
+
+            entry.aspect = QskAspect();
+            return entry;
+        }
+
+        QHash< Key, Entry > m_entries;
+
+        // for all skinnables with local hints, that are resolved in a thread
+        const int m_budget = 4096;
+    };
+}
+
+static LocalHintCache& qskLocalHintCache()
+{
+    /*
+        Hints are resolved in the GUI thread, but also in the scene graph
+        threads, while updating the nodes. Each thread has its own cache,
+        so that no locking is needed and the returned entries can't be
+        modified by another thread.
+     */
+    static thread_local LocalHintCache cache;
+    return cache;
+}
+
+namespace
+{
+    class FontMetrics
+    {
+      public:
+        qreal height = 0.0;
+        qreal ascent = 0.0;
+        qreal averageCharWidth = 0.0;
+    };
+
+    /*
+        During a skin transition the pixel sizes of the fonts are animated
+        and the metrics cached by the skin can't be used. As all controls
+        are running through the same sizes we memoize the metrics of the
+        animated fonts as well. Pixel sizes don't depend on the logical DPI,
+        so the entries don't need to be invalidated.
+     */
+    class AnimatedFontCache
+    {
+      public:
+        const FontMetrics& metrics( const QFont& font )
+        {
+            auto it = m_entries.constFind( font );
+            if ( it == m_entries.constEnd() )
+            {
+                if ( m_entries.size() >= m_budget )
+                    m_entries.clear();
+
+                const QFontMetricsF fm( font );
+
+                FontMetrics metrics;
+                metrics.height = fm.height();
+                metrics.ascent = fm.ascent();
+                metrics.averageCharWidth = fm.averageCharWidth();
+
+                it = m_entries.insert( font, metrics );
+            }
+
+            return it.value();
+        }
+
+      private:
+        QHash< QFont, FontMetrics > m_entries;
+        const int m_budget = 256;
+    };
+}
+
+Q_GLOBAL_STATIC( AnimatedFontCache, qskAnimatedFontCache )
+
+namespace
+{
+    class StateMasks
+    {
+      public:
+        inline StateMasks& operator|=( const StateMasks& other )
+        {
+            colorStates |= other.colorStates;
+            otherStates |= other.otherStates;
+
+            return *this;
+        }
+
+        // states, that are used by color hints
+        QskAspect::States colorStates;
+
+        // states, that are used by all other hints
+        QskAspect::States otherStates;
+    };
+
+    /*
+        The states, that are used by the hints of each subcontrol. They
+        are collected once for each generation of a table, so that changing
+        the states of a skinnable does not need to resolve any hint to find
+        out which nodes are affected.
+
+        Skinnables of the same class share the skin table, and local tables
+        with identical hints share their generation as well.
+     */
+    class StateMaskCache
+    {
+      public:
+        StateMasks masks( const QskSkinHintTable& table,
+            QskAspect::Subcontrol subControl )
+        {
+            if ( !table.hasHints() )
+                return StateMasks();
+
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_tables.constFind( table.generation() );
+            if ( it == m_tables.constEnd() )
+            {
+                if ( m_tables.size() >= m_budget )
+                    m_tables.clear();
+
+                it = m_tables.insert( table.generation(), collect( table ) );
+            }
+
+            return it->value( subControl ) | it->value( QskAspect::NoSubcontrol );
+        }
+
+      private:
+        using TableMasks = QHash< quint16, StateMasks >;
+
+        static TableMasks collect( const QskSkinHintTable& table )
+        {
+            TableMasks tableMasks;
+
+            const auto hints = table.hints();
+            for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+            {
+                const auto aspect = it.key();
+                if ( aspect.isAnimator() || !aspect.hasStates() )
+                    continue;
+
+                auto& masks = tableMasks[ aspect.subControl() ];
+
+                if ( aspect.isColor() )
+                    masks.colorStates |= aspect.states();
+                else
+                    masks.otherStates |= aspect.states();
+            }
+
+            return tableMasks;
+        }
+
+        QMutex m_mutex;
+        QHash< uint, TableMasks > m_tables;
+
+        const int m_budget = 64;
+    };
+
+    inline StateMasks operator|( StateMasks masks1, const StateMasks& masks2 )
+    {
+        return masks1 |= masks2;
+    }
+}
+
+Q_GLOBAL_STATIC( StateMaskCache, qskStateMaskCache )
+
+static void qskSynchronizePartialUpdate( void* object, QQuickWindow* )
+{
+    /*
+        Called, when the scene graph is synchronized - before
+        QQuickItem::updatePaintNode. As QQuickItem::update is not virtual
+        we can't know what has been modified, when it has been called
+        in the same frame as the requests of a partial update.
+     */
+    auto skinnable = static_cast< QskSkinnable* >( object );
+
+    const auto item = skinnable->owningItem();
+    if ( item == nullptr || !item->isVisible() || qskIsUpdateRequested( item ) )
+        skinnable->setAllSubcontrolsDirty();
+}
+
 class QskSkinnable::PrivateData
 {
   public:
@@ -246,6 +540,47 @@ class QskSkinnable::PrivateData
         delete subcontrolProxies;
     }
 
+    /*
+        The hint from the local or the skin table. The skin has
+        to be populated for the subcontrol of the aspect before.
+     */
+    QskSkinHintTable::Hint resolvedHint( const QskSkin* skin,
+        QskAspect aspect, QskSkinHintStatus* status )
+    {
+        if ( hintTable.hasHints() )
+        {
+            const auto& entry = qskLocalHintCache().entry( hintTable, skin, aspect );
+
+            if ( status )
+            {
+                status->source = entry.source;
+                status->aspect = entry.aspect;
+            }
+
+            return entry.value;
+        }
+
+        QskAspect resolvedAspect;
+
+        const auto hint = skin->resolvedHint( aspect, &resolvedAspect );
+
+        if ( status )
+        {
+            if ( hint )
+            {
+                status->source = QskSkinHintStatus::Skin;
+                status->aspect = resolvedAspect;
+            }
+            else
+            {
+                status->source = QskSkinHintStatus::NoSource;
+                status->aspect = QskAspect();
+            }
+        }
+
+        return hint;
+    }
+
     QskSkinHintTable hintTable;
     QskHintAnimatorTable animators;
 
@@ -258,6 +593,36 @@ class QskSkinnable::PrivateData
 
     QskAspect::States skinStates;
     bool hasLocalSkinlet = false;
+
+    // local hints, that have been modified since shareSkinHints()
+    bool hasUnsharedHints = false;
+
+    /*
+        Unless a partial update has been requested explicitly all nodes
+        are considered being dirty. This way updates requested by
+        QQuickItem::update - what is not virtual - are always full updates.
+     */
+    class DirtySubcontrols
+    {
+      public:
+        QVector< QskAspect::Subcontrol > subControls;
+        QVector< int > samples;
+
+        // a full update has been requested explicitly
+        bool all = false;
+
+        // only subControls/samples are dirty
+        bool partial = false;
+    };
+
+    // modifications since the last update of the nodes
+    DirtySubcontrols pendingDirty;
+
+    // modifications, that are considered in the running update of the nodes
+    DirtySubcontrols dirty;
+
+    // the window, where a partial update has been enqueued
+    QQuickWindow* partialUpdateWindow = nullptr;
 };
 
 QskSkinnable::QskSkinnable()
@@ -267,6 +632,7 @@ QskSkinnable::QskSkinnable()
 
 QskSkinnable::~QskSkinnable()
 {
+    QskSyncQueue::dequeue( m_data->partialUpdateWindow, this );
 }
 
 void QskSkinnable::setSkinlet( const QskSkinlet* skinlet )
@@ -295,7 +661,10 @@ void QskSkinnable::setSkinlet( const QskSkinlet* skinlet )
         item->polish();
 
         if ( item->flags() & QQuickItem::ItemHasContents )
+        {
+            setAllSubcontrolsDirty();
             item->update();
+        }
     }
 }
 
@@ -419,7 +788,10 @@ bool QskSkinnable::moveColor( const QskAspect aspect, QRgb rgb )
 
 QColor QskSkinnable::color( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect, status );
+    QColor value;
+    ( void ) effectiveTypedHint( aspect | QskAspect::Color, value, status );
+
+    return value;
 }
 
 bool QskSkinnable::setMetric( const QskAspect aspect, qreal metric )
@@ -434,14 +806,17 @@ bool QskSkinnable::moveMetric( QskAspect aspect, qreal metric )
 
 qreal QskSkinnable::metric( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect, status );
+    qreal value = 0.0;
+    ( void ) effectiveTypedHint( aspect | QskAspect::Metric, value, status );
+
+    return value;
 }
 
 qreal QskSkinnable::metric( QskAspect aspect, qreal defaultValue ) const
 {
     QskSkinHintStatus status;
 
-    const auto value = qskMetric< qreal >( this, aspect, &status );
+    const auto value = metric( aspect, &status );
     return status.isValid() ? value : defaultValue;
 }
 
@@ -468,7 +843,7 @@ bool QskSkinnable::resetPositionHint( QskAspect aspect )
 
 qreal QskSkinnable::positionHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Position, status );
+    return metric( aspect | QskAspect::Position, status );
 }
 
 bool QskSkinnable::setStrutSizeHint(
@@ -631,15 +1006,31 @@ bool QskSkinnable::resetShadowColorHint( QskAspect aspect )
 
 QColor QskSkinnable::shadowColorHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect | QskAspect::Shadow, status );
+    return color( aspect | QskAspect::Shadow, status );
 }
 
 QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
 {
+    const QskAspect aspects[] =
+    {
+        aspect | QskAspect::Metric | QskAspect::Shape,
+        aspect | QskAspect::Metric | QskAspect::Border,
+        aspect | QskAspect::Color | QskAspect::Border,
+        aspect | QskAspect::Color,
+        aspect | QskAspect::Metric | QskAspect::Shadow,
+        aspect | QskAspect::Color | QskAspect::Shadow
+    };
+
+    QVariant hints[ 6 ];
+    effectiveSkinHints( 6, aspects, hints );
+
     return QskBoxHints(
-        boxShapeHint( aspect ), boxBorderMetricsHint( aspect ),
-        boxBorderColorsHint( aspect ), gradientHint( aspect ),
-        shadowMetricsHint( aspect ), shadowColorHint( aspect ) );
+        hints[ 0 ].value< QskBoxShapeMetrics >(),
+        hints[ 1 ].value< QskBoxBorderMetrics >(),
+        hints[ 2 ].value< QskBoxBorderColors >(),
+        hints[ 3 ].value< QskGradient >(),
+        hints[ 4 ].value< QskShadowMetrics >(),
+        hints[ 5 ].value< QColor >() );
 }
 
 bool QskSkinnable::setArcMetricsHint(
@@ -691,7 +1082,7 @@ bool QskSkinnable::resetSpacingHint( const QskAspect aspect )
 qreal QskSkinnable::spacingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Spacing, status );
+    return metric( aspect | QskAspect::Spacing, status );
 }
 
 bool QskSkinnable::setTextOptionsHint(
@@ -732,9 +1123,10 @@ QskFontRole QskSkinnable::fontRoleHint(
         aspect | QskAspect::FontRole, status ).value< QskFontRole >();
 }
 
-QFont QskSkinnable::effectiveFont( QskAspect aspect ) const
+static QFont qskEffectiveFont( const QskSkinnable* skinnable,
+    QskAspect aspect, FontMetrics* metrics )
 {
-    const auto hint = effectiveSkinHint( aspect | QskAspect::FontRole );
+    const auto hint = skinnable->effectiveSkinHint( aspect | QskAspect::FontRole );
     if ( hint.canConvert< QFont >() )
     {
         /*
@@ -742,14 +1134,26 @@ QFont QskSkinnable::effectiveFont( QskAspect aspect ) const
             application code might want to assign fonts without defining
             font roles.
          */
-        return hint.value< QFont >();
+        const auto font = hint.value< QFont >();
+
+        if ( metrics )
+        {
+            const QFontMetricsF fm( font );
+
+            metrics->height = fm.height();
+            metrics->ascent = fm.ascent();
+            metrics->averageCharWidth = fm.averageCharWidth();
+        }
+
+        return font;
     }
 
     const auto fontRole = hint.value< QskFontRole >();
+    const auto skin = skinnable->effectiveSkin();
 
-    auto font = effectiveSkin()->font( fontRole );
+    auto font = skin->font( fontRole );
 
-    if ( auto item = owningItem() )
+    if ( auto item = skinnable->owningItem() )
     {
         const auto v = QskSkinTransition::animatedFontSize(
             item->window(), fontRole );
@@ -757,17 +1161,71 @@ QFont QskSkinnable::effectiveFont( QskAspect aspect ) const
         if ( v.canConvert< int >() )
         {
             font.setPixelSize( v.value< int >() );
-            item->update(); // design flaw: see effectiveGraphicFilter
+
+            // design flaw: see effectiveGraphicFilter
+            const_cast< QskSkinnable* >( skinnable )->setAllSubcontrolsDirty();
+            item->update();
+
+            if ( metrics )
+                *metrics = qskAnimatedFontCache->metrics( font );
+
+            return font;
         }
     }
 
+    /*
+        Without font sizes being animated we can use the
+        metrics, that have been cached by the skin.
+     */
+    if ( metrics )
+    {
+        metrics->height = skin->fontHeight( fontRole );
+        metrics->ascent = skin->fontAscent( fontRole );
+        metrics->averageCharWidth = skin->fontAverageCharWidth( fontRole );
+    }
+
+    return font;
+}
+
+QFont QskSkinnable::effectiveFont( QskAspect aspect ) const
+{
+    return qskEffectiveFont( this, aspect, nullptr );
+}
+
+QFont QskSkinnable::effectiveFont( QskAspect aspect, qreal* fontHeight ) const
+{
+    if ( fontHeight == nullptr )
+        return qskEffectiveFont( this, aspect, nullptr );
+
+    FontMetrics metrics;
+    const auto font = qskEffectiveFont( this, aspect, &metrics );
+
+    *fontHeight = metrics.height;
     return font;
 }
 
 qreal QskSkinnable::effectiveFontHeight( const QskAspect aspect ) const
 {
-    const QFontMetricsF fm( effectiveFont( aspect ) );
-    return fm.height();
+    FontMetrics metrics;
+    ( void ) qskEffectiveFont( this, aspect, &metrics );
+
+    return metrics.height;
+}
+
+qreal QskSkinnable::effectiveFontAscent( const QskAspect aspect ) const
+{
+    FontMetrics metrics;
+    ( void ) qskEffectiveFont( this, aspect, &metrics );
+
+    return metrics.ascent;
+}
+
+qreal QskSkinnable::effectiveFontAverageCharWidth( const QskAspect aspect ) const
+{
+    FontMetrics metrics;
+    ( void ) qskEffectiveFont( this, aspect, &metrics );
+
+    return metrics.averageCharWidth;
 }
 
 bool QskSkinnable::setGraphicRoleHint( const QskAspect aspect, int role )
@@ -783,7 +1241,10 @@ bool QskSkinnable::resetGraphicRoleHint( const QskAspect aspect )
 int QskSkinnable::graphicRoleHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskFlag( this, aspect | QskAspect::GraphicRole, status );
+    int role = 0;
+    ( void ) effectiveTypedHint( aspect | QskAspect::GraphicRole, role, status );
+
+    return role;
 }
 
 bool QskSkinnable::setSymbolHint(
@@ -852,6 +1313,7 @@ QskColorFilter QskSkinnable::effectiveGraphicFilter(
                 filter. As a workaround we schedule the update in the
                 getter: TODO ...
              */
+            const_cast< QskSkinnable* >( this )->setAllSubcontrolsDirty();
             item->update();
 #endif
             return v.value< QskColorFilter >();
@@ -865,7 +1327,14 @@ bool QskSkinnable::setAnimationHint(
     QskAspect aspect, QskAnimationHint hint )
 {
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
-    return m_data->hintTable.setAnimation( aspect, hint );
+
+    if ( m_data->hintTable.setAnimation( aspect, hint ) )
+    {
+        m_data->hasUnsharedHints = true;
+        return true;
+    }
+
+    return false;
 }
 
 QskAnimationHint QskSkinnable::animationHint(
@@ -910,6 +1379,8 @@ QskAnimationHint QskSkinnable::effectiveAnimation(
 
     if ( auto skin = effectiveSkin() )
     {
+        skin->populateHints( subControl );
+
         const auto a = skin->hintTable().resolvedAnimator( aspect, hint );
         if ( a.isAnimator() )
         {
@@ -938,7 +1409,8 @@ bool QskSkinnable::setSkinHint( QskAspect aspect, const QVariant& hint )
 
     if ( m_data->hintTable.setHint( aspect, hint ) )
     {
-        qskTriggerUpdates( aspect, owningItem() );
+        m_data->hasUnsharedHints = true;
+        qskTriggerUpdates( aspect, this );
         return true;
     }
 
@@ -951,7 +1423,8 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 
     if ( m_data->hintTable.removeHint( aspect ) )
     {
-        qskTriggerUpdates( aspect, owningItem() );
+        m_data->hasUnsharedHints = true;
+        qskTriggerUpdates( aspect, this );
         return true;
     }
 
@@ -961,6 +1434,14 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
+#ifdef QSK_HINT_PROFILER
+    QskSkinHintStatus profiledStatus;
+    if ( status == nullptr )
+        status = &profiledStatus;
+
+    const QskSkinHintProfiler::Query query( aspect, status );
+#endif
+
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
 
     if ( !( aspect.isAnimator() || aspect.hasStates() ) )
@@ -993,6 +1474,124 @@ QVariant QskSkinnable::effectiveSkinHint(
     return storedHint( aspect, status );
 }
 
+static inline QskAspect qskEffectiveAspect(
+    const QskSkinnable* skinnable, QskAspect aspect )
+{
+    // filling in what is not explicitly specified from the skinnable
+
+    aspect.setSubcontrol( skinnable->effectiveSubcontrol( aspect.subControl() ) );
+
+    if ( aspect.section() == QskAspect::Body )
+        aspect.setSection( skinnable->section() );
+
+    if ( aspect.variation() == QskAspect::NoVariation )
+        aspect.setVariation( skinnable->effectiveVariation() );
+
+    if ( !aspect.hasStates() )
+        aspect.setStates( skinnable->skinStates() );
+
+    return aspect;
+}
+
+void QskSkinnable::effectiveSkinHints(
+    int count, const QskAspect* aspects, QVariant* hints ) const
+{
+    if ( count <= 0 )
+        return;
+
+#ifndef QSK_HINT_PROFILER
+    if ( m_data->animators.isEmpty() && !QskSkinTransition::isRunning() )
+    {
+        auto aspect = qskEffectiveAspect( this, aspects[ 0 ] );
+
+        const auto skin = effectiveSkin();
+        skin->populateHints( aspect.subControl() );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            Q_ASSERT( aspects[ i ].subControl() == aspects[ 0 ].subControl() );
+
+            aspect.setPrimitive( aspects[ i ].type(), aspects[ i ].primitive() );
+            hints[ i ] = m_data->resolvedHint( skin, aspect, nullptr ).value();
+        }
+
+        return;
+    }
+#endif
+
+    // running animators are rare: no need to optimize for them
+
+    for ( int i = 0; i < count; i++ )
+        hints[ i ] = effectiveSkinHint( aspects[ i ] );
+}
+
+static inline bool qskConvertedHint( const QVariant& hint, qreal& metric )
+{
+    if ( hint.isValid() && hint.canConvert< qreal >() )
+    {
+        metric = hint.value< qreal >();
+        return true;
+    }
+
+    return false;
+}
+
+static inline bool qskConvertedHint( const QVariant& hint, QColor& color )
+{
+    if ( hint.isValid() && hint.canConvert< QColor >() )
+    {
+        color = hint.value< QColor >();
+        return true;
+    }
+
+    return false;
+}
+
+static inline bool qskConvertedHint( const QVariant& hint, int& flag )
+{
+    if ( hint.isValid() && hint.canConvert< int >() )
+    {
+        flag = hint.value< int >();
+        return true;
+    }
+
+    return false;
+}
+
+template< typename T >
+bool QskSkinnable::effectiveTypedHint(
+    QskAspect aspect, T& value, QskSkinHintStatus* status ) const
+{
+    /*
+        Same as effectiveSkinHint, but without having to copy/unbox
+        a QVariant for the most common types. Running animators are
+        rare and we simply use the QVariant based implementation then.
+     */
+
+#ifdef QSK_HINT_PROFILER
+    QskSkinHintStatus profiledStatus;
+    if ( status == nullptr )
+        status = &profiledStatus;
+
+    const QskSkinHintProfiler::Query query( aspect, status );
+#endif
+
+    if ( !m_data->animators.isEmpty() || QskSkinTransition::isRunning() )
+        return qskConvertedHint( effectiveSkinHint( aspect, status ), value );
+
+    aspect = qskEffectiveAspect( this, aspect );
+
+    const auto skin = effectiveSkin();
+    skin->populateHints( aspect.subControl() );
+
+    return m_data->resolvedHint( skin, aspect, status ).typedValue( value );
+}
+
+bool QskSkinnable::effectiveFlagHint( QskAspect aspect, int& flag ) const
+{
+    return effectiveTypedHint( aspect, flag, nullptr );
+}
+
 QskSkinHintStatus QskSkinnable::hintStatus( QskAspect aspect ) const
 {
     QskSkinHintStatus status;
@@ -1125,71 +1724,13 @@ QVariant QskSkinnable::interpolatedHint(
     return v;
 }
 
-const QVariant& QskSkinnable::storedHint(
+QVariant QskSkinnable::storedHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
     const auto skin = effectiveSkin();
+    skin->populateHints( aspect.subControl() );
 
-    QskAspect resolvedAspect;
-
-    const auto& localTable = m_data->hintTable;
-    if ( localTable.hasHints() )
-    {
-        if ( const auto value = localTable.resolvedHint( aspect, &resolvedAspect ) )
-        {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skinnable;
-                status->aspect = resolvedAspect;
-            }
-            return *value;
-        }
-    }
-
-    // next we try the hints from the skin
-
-    const auto& skinTable = skin->hintTable();
-    if ( skinTable.hasHints() )
-    {
-        if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
-        {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skin;
-                status->aspect = resolvedAspect;
-            }
-
-            return *value;
-        }
-
-        if ( aspect.hasSubcontrol() )
-        {
-            // trying to resolve something from the skin default settings
-
-            aspect.clearSubcontrol();
-            aspect.clearStates();
-
-            if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
-            {
-                if ( status )
-                {
-                    status->source = QskSkinHintStatus::Skin;
-                    status->aspect = resolvedAspect;
-                }
-
-                return *value;
-            }
-        }
-    }
-
-    if ( status )
-    {
-        status->source = QskSkinHintStatus::NoSource;
-        status->aspect = QskAspect();
-    }
-
-    static QVariant hintInvalid;
-    return hintInvalid;
+    return m_data->resolvedHint( skin, aspect, status ).value();
 }
 
 bool QskSkinnable::hasSkinState( QskAspect::State state ) const
@@ -1392,8 +1933,8 @@ void QskSkinnable::setSkinStateFlag( QskAspect::State stateFlag, bool on )
     setSkinStates( newState );
 }
 
-void QskSkinnable::replaceSkinStates(
-    QskAspect::States newStates, int sampleIndex )
+void QskSkinnable::bindSkinStates(
+    QskAspect::States*& states, int*& sampleIndex )
 {
     /*
         Hack time: we might need different hints for a specific instance
@@ -1401,11 +1942,12 @@ void QskSkinnable::replaceSkinStates(
         supported by QskAspect.
 
         As a workaround we use QskSkinStateChanger, that sets/restores this state/index
-        while retrieving the skin hints.
+        while retrieving the skin hints. It gets the addresses once, so that
+        switching between the samples of a series is an inline assignment.
      */
 
-    m_data->skinStates = newStates;
-    m_data->sampleIndex = sampleIndex; // needed to find specific animators
+    states = &m_data->skinStates;
+    sampleIndex = &m_data->sampleIndex; // needed to find specific animators
 }
 
 void QskSkinnable::addSkinStates( QskAspect::States states )
@@ -1437,6 +1979,9 @@ void QskSkinnable::setSkinStates( QskAspect::States newStates )
     {
         if ( const auto skin = effectiveSkin() )
         {
+            // the states of the skin table are known after populating the class
+            skin->populateHints( metaObject() );
+
             const auto mask = m_data->hintTable.states() | skin->hintTable().states();
             if ( ( newStates & mask ) != ( m_data->skinStates & mask ) )
             {
@@ -1450,12 +1995,68 @@ void QskSkinnable::setSkinStates( QskAspect::States newStates )
         }
 
         if ( item->flags() & QQuickItem::ItemHasContents )
-            item->update();
+            setSkinStatesDirty( m_data->skinStates, newStates );
     }
 
     m_data->skinStates = newStates;
 }
 
+void QskSkinnable::setSkinStatesDirty(
+    QskAspect::States oldStates, QskAspect::States newStates )
+{
+    /*
+        Finding the subcontrols with hints for the modified states.
+        As long as only colors are affected the nodes of the other
+        subcontrols can be kept.
+     */
+
+    const auto changedStates = oldStates ^ newStates;
+
+    const auto skin = effectiveSkin();
+    const auto control = qskControlCast( owningItem() );
+
+    bool fullUpdate = ( skin == nullptr ) || ( control == nullptr );
+
+    QVector< QskAspect::Subcontrol > dirtySubcontrols;
+
+    if ( !fullUpdate )
+    {
+        const auto subControls = control->subControls();
+        for ( const auto subControl : subControls )
+        {
+            const auto effectiveSubControl = effectiveSubcontrol( subControl );
+            skin->populateHints( effectiveSubControl );
+
+            const auto masks =
+                qskStateMaskCache->masks( skin->hintTable(), effectiveSubControl )
+                | qskStateMaskCache->masks( m_data->hintTable, effectiveSubControl );
+
+            if ( changedStates & masks.otherStates )
+            {
+                // might have an effect on the geometries of other subcontrols
+                fullUpdate = true;
+                break;
+            }
+
+            if ( changedStates & masks.colorStates )
+                dirtySubcontrols += subControl;
+        }
+    }
+
+    if ( fullUpdate )
+    {
+        setAllSubcontrolsDirty();
+
+        if ( auto item = owningItem() )
+            item->update();
+
+        return;
+    }
+
+    for ( const auto subControl : std::as_const( dirtySubcontrols ) )
+        setSubcontrolDirty( subControl );
+}
+
 bool QskSkinnable::startHintTransitions(
     QskAspect::States oldStates, QskAspect::States newStates, int index )
 {
@@ -1493,6 +2094,7 @@ bool QskSkinnable::startHintTransitions(
     for ( const auto subControl : subControls )
     {
         aspect.setSubcontrol( subControl );
+        skin->populateHints( subControl );
 
         const auto& skinTable = skin->hintTable();
 
@@ -1597,6 +2199,142 @@ QskAspect::Subcontrol QskSkinnable::substitutedSubcontrol(
     return subControl;
 }
 
+bool QskSkinnable::startPartialUpdate()
+{
+    auto& dirty = m_data->pendingDirty;
+
+    if ( dirty.all )
+        return false;
+
+    if ( !dirty.partial )
+    {
+        /*
+            When an update has already been requested by QQuickItem::update
+            we don't know what has been modified and have to stay with
+            a full update.
+         */
+        const auto control = qskControlCast( owningItem() );
+        const auto window = control ? control->window() : nullptr;
+
+        if ( window == nullptr || qskIsUpdateRequested( control ) )
+        {
+            setAllSubcontrolsDirty();
+            return false;
+        }
+
+        /*
+            QQuickItem::update might also be called later - the state
+            of the item is checked again, when synchronizing the scene graph.
+         */
+        if ( m_data->partialUpdateWindow != window )
+        {
+            QskSyncQueue::dequeue( m_data->partialUpdateWindow, this );
+            m_data->partialUpdateWindow = window;
+        }
+
+        QskSyncQueue::enqueue( window, this, qskSynchronizePartialUpdate );
+        qskRequestNodeUpdate( control );
+
+        dirty.partial = true;
+    }
+
+    return true;
+}
+
+void QskSkinnable::setSubcontrolDirty( QskAspect::Subcontrol subControl )
+{
+    if ( subControl != QskAspect::NoSubcontrol && startPartialUpdate() )
+    {
+        auto& subControls = m_data->pendingDirty.subControls;
+        if ( !subControls.contains( subControl ) )
+            subControls += subControl;
+
+        return;
+    }
+
+    setAllSubcontrolsDirty();
+
+    if ( auto item = owningItem() )
+        item->update();
+}
+
+void QskSkinnable::setAllSubcontrolsDirty()
+{
+    auto& dirty = m_data->pendingDirty;
+
+    dirty.all = true;
+    dirty.partial = false;
+    dirty.subControls.clear();
+    dirty.samples.clear();
+}
+
+bool QskSkinnable::isSubcontrolDirty( QskAspect::Subcontrol subControl ) const
+{
+    const auto& dirty = m_data->dirty;
+
+    if ( !dirty.partial )
+        return true;
+
+    return dirty.subControls.contains( subControl )
+        || dirty.subControls.contains( effectiveSubcontrol( subControl ) );
+}
+
+void QskSkinnable::setSampleDirty( int index )
+{
+    if ( index < 0 )
+        return;
+
+    if ( startPartialUpdate() )
+    {
+        auto& samples = m_data->pendingDirty.samples;
+        if ( !samples.contains( index ) )
+            samples += index;
+
+        return;
+    }
+
+    if ( auto item = owningItem() )
+        item->update();
+}
+
+bool QskSkinnable::isSampleDirty(
+    QskAspect::Subcontrol subControl, int index ) const
+{
+    return isSubcontrolDirty( subControl )
+        || m_data->dirty.samples.contains( index );
+}
+
+bool QskSkinnable::hasDirtySamples() const
+{
+    const auto& dirty = m_data->dirty;
+    return !dirty.partial || !dirty.samples.isEmpty();
+}
+
+void QskSkinnable::shareSkinHints()
+{
+    /*
+        Sharing is delayed until the customization has been settled.
+        Otherwise each modification would have to detach from the
+        copy in the pool.
+     */
+    if ( m_data->hasUnsharedHints )
+    {
+        m_data->hasUnsharedHints = false;
+        m_data->hintTable.shareHints();
+    }
+}
+
+void QskSkinnable::startNodeUpdate()
+{
+    /*
+        Modifications, that happen while updating the nodes -
+        f.e. from the getters for animated fonts - are considered
+        for the next update.
+     */
+    m_data->dirty = m_data->pendingDirty;
+    m_data->pendingDirty = PrivateData::DirtySubcontrols();
+}
+
 QskControl* QskSkinnable::controlCast()
 {
     return qskIsControl( this )
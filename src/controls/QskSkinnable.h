@@ -86,7 +86,10 @@ class QSK_EXPORT QskSkinnable
     const QskSkinlet* skinlet() const;
 
     QFont effectiveFont( QskAspect ) const;
+    QFont effectiveFont( QskAspect, qreal* fontHeight ) const;
     qreal effectiveFontHeight( QskAspect ) const;
+    qreal effectiveFontAscent( QskAspect ) const;
+    qreal effectiveFontAverageCharWidth( QskAspect ) const;
     QskColorFilter effectiveGraphicFilter( QskAspect::Subcontrol ) const;
 
     void setSubcontrolProxy( QskAspect::Subcontrol, QskAspect::Subcontrol proxy );
@@ -107,6 +110,14 @@ class QSK_EXPORT QskSkinnable
         QskAspect::States, QskSkinHintStatus* status = nullptr ) const;
 
     QVariant effectiveSkinHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+
+    /*
+        Resolving the hints for aspects, that differ in type/primitive only.
+        Expanding subcontrol, section, variation and states is done once
+        for all of them.
+     */
+    void effectiveSkinHints( int count, const QskAspect*, QVariant* ) const;
+
     virtual QskAspect::Variation effectiveVariation() const;
 
     virtual QskAspect::Section section() const;
@@ -158,6 +169,34 @@ class QSK_EXPORT QskSkinnable
     const char* skinStatesAsPrintable() const;
     const char* skinStatesAsPrintable( QskAspect::States ) const;
 
+    /*
+        Modifications, that allow updating the scene graph nodes partially:
+        see QskSkinlet::setNodeRoleSubcontrol.
+
+        Setting/animating color hints or changing states, that affect
+        the colors of some subcontrols only, results in a partial update.
+        setSubcontrolDirty/setSampleDirty schedule the update of the nodes,
+        there is no need to call QQuickItem::update.
+
+        Any other update - f.e. from QQuickItem::update - updates all nodes,
+        even when it has been requested after a partial update in the same frame.
+     */
+    void setSubcontrolDirty( QskAspect::Subcontrol );
+    void setAllSubcontrolsDirty();
+
+    bool isSubcontrolDirty( QskAspect::Subcontrol ) const;
+
+    /*
+        Modifications, that affect a single sample of the series
+        ( see QskSkinlet::updateSeriesNode ) only: f.e. the pressed
+        button of a QskRadioBox. The index is not bound to a specific subcontrol,
+        so all series will update the node for this sample.
+     */
+    void setSampleDirty( int index );
+
+    bool isSampleDirty( QskAspect::Subcontrol, int index ) const;
+    bool hasDirtySamples() const;
+
     // type aware methods for accessing skin hints
 
     bool setColor( QskAspect, Qt::GlobalColor );
@@ -269,6 +308,12 @@ class QSK_EXPORT QskSkinnable
 
   protected:
     virtual void updateNode( QSGNode* );
+
+    // to be called before updateNode
+    void startNodeUpdate();
+
+    // sharing the local hints with other skinnables of identical hints
+    void shareSkinHints();
     virtual bool isTransitionAccepted( QskAspect ) const;
 
     virtual QskAspect::Subcontrol substitutedSubcontrol( QskAspect::Subcontrol ) const;
@@ -283,10 +328,17 @@ class QSK_EXPORT QskSkinnable
 
     QVariant animatedHint( QskAspect, QskSkinHintStatus* ) const;
     QVariant interpolatedHint( QskAspect, QskSkinHintStatus* ) const;
-    const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+    QVariant storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+
+    template< typename T >
+    bool effectiveTypedHint( QskAspect, T&, QskSkinHintStatus* ) const;
+    bool effectiveFlagHint( QskAspect, int& ) const;
+
+    bool startPartialUpdate();
+    void setSkinStatesDirty( QskAspect::States, QskAspect::States );
 
     friend class QskSkinStateChanger;
-    void replaceSkinStates( QskAspect::States, int sampleIndex = -1 );
+    void bindSkinStates( QskAspect::States*&, int*& sampleIndex );
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -295,9 +347,9 @@ class QSK_EXPORT QskSkinnable
 template< typename T >
 inline T QskSkinnable::flagHint( QskAspect aspect, T defaultValue ) const
 {
-    const auto& hint = effectiveSkinHint( aspect );
-    if ( hint.isValid() && hint.canConvert< int >() )
-        return static_cast< T >( hint.value< int >() );
+    int flag;
+    if ( effectiveFlagHint( aspect, flag ) )
+        return static_cast< T >( flag );
 
     return defaultValue;
 }
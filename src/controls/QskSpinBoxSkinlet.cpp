@@ -292,7 +292,7 @@ QSizeF QskSpinBoxSkinlet::sizeHint( const QskSkinnable* skinnable,
             spinBox->textFromValue( spinBox->maximum() ).left( 18 ) );
 
         hint.setWidth( std::max( w1, w2 ) );
-        hint.setHeight( fm.height() );
+        hint.setHeight( spinBox->effectiveFontHeight( Q::Text ) );
 
         hint = hint.grownBy( spinBox->paddingHint( Q::TextPanel ) );
         hint = hint.expandedTo( spinBox->strutSizeHint( Q::TextPanel ) );
@@ -135,9 +135,8 @@ qreal QskSubWindowSkinlet::titleBarHeight( const QskSubWindow* subWindow ) const
     if ( decorations & Q::Title )
     {
         const auto padding = subWindow->paddingHint( Q::TitleBarPanel );
-        const QFontMetricsF fm( subWindow->effectiveFont( Q::TitleBarText ) );
-
-        const qreal h = fm.height() + padding.top() + padding.bottom();
+        const qreal h = subWindow->effectiveFontHeight( Q::TitleBarText )
+            + padding.top() + padding.bottom();
         if ( h > height )
             height = h;
     }
@@ -189,8 +188,8 @@ QRectF QskSubWindowSkinlet::titleRect(
         }
 
 #if 0
-        const QFontMetricsF fm( subWindow->effectiveFont( Q::TitleBarText ) );
-        rect.setHeight( fm.height() ); // TitleBarText | Alignment
+        rect.setHeight( subWindow->effectiveFontHeight(
+            Q::TitleBarText ) ); // TitleBarText | Alignment
 #endif
     }
 
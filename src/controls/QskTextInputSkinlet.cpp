@@ -63,9 +63,18 @@ QSizeF QskTextInputSkinlet::sizeHint( const QskSkinnable* skinnable,
 
     const auto text = static_cast< const QskTextInput* >( skinnable )->text();
 
-    const QFontMetricsF fm( skinnable->effectiveFont( Q::Text ) );
+    QSizeF hint;
 
-    auto hint = fm.size( Qt::TextSingleLine | Qt::TextExpandTabs, text );
+    if ( text.isEmpty() )
+    {
+        hint.setWidth( 0.0 );
+        hint.setHeight( skinnable->effectiveFontHeight( Q::Text ) );
+    }
+    else
+    {
+        const QFontMetricsF fm( skinnable->effectiveFont( Q::Text ) );
+        hint = fm.size( Qt::TextSingleLine | Qt::TextExpandTabs, text );
+    }
 
     hint = skinnable->outerBoxSize( Q::TextPanel, hint );
     hint = hint.expandedTo( skinnable->strutSizeHint( Q::TextPanel ) );
@@ -9,13 +9,15 @@
 #include "QskTextOptions.h"
 #include "QskTextRenderer.h"
 
-#include <qfontmetrics.h>
 #include <qmath.h>
 
 QskTextLabelSkinlet::QskTextLabelSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
     setNodeRoles( { PanelRole, TextRole } );
+
+    setNodeRoleSubcontrol( PanelRole, QskTextLabel::Panel );
+    setNodeRoleSubcontrol( TextRole, QskTextLabel::Text );
 }
 
 QskTextLabelSkinlet::~QskTextLabelSkinlet() = default;
@@ -75,7 +77,8 @@ QSizeF QskTextLabelSkinlet::sizeHint( const QskSkinnable* skinnable,
 
     const auto label = static_cast< const QskTextLabel* >( skinnable );
 
-    const auto font = label->effectiveFont( QskTextLabel::Text );
+    qreal lineHeight;
+    const auto font = label->effectiveFont( QskTextLabel::Text, &lineHeight );
 
     auto textOptions = label->textOptions();
     textOptions.setFormat( label->effectiveTextFormat() );
@@ -84,8 +87,6 @@ QSizeF QskTextLabelSkinlet::sizeHint( const QskSkinnable* skinnable,
 
     QSizeF hint;
 
-    const qreal lineHeight = QFontMetricsF( font ).height();
-
     if ( text.isEmpty() )
     {
         if ( constraint.height() < 0.0 )
@@ -13,7 +13,6 @@
 
 #include <qdebug.h>
 #include <qfont.h>
-#include <qfontmetrics.h>
 #include <qmath.h>
 
 QskSubcontrolLayoutEngine::LayoutElement::LayoutElement(
@@ -141,7 +140,8 @@ QSizeF QskSubcontrolLayoutEngine::LayoutElement::sizeHint(
 
 QSizeF QskSubcontrolLayoutEngine::TextElement::implicitSize( const QSizeF& constraint ) const
 {
-    const auto font = skinnable()->effectiveFont( subControl() );
+    qreal lineHeight;
+    const auto font = skinnable()->effectiveFont( subControl(), &lineHeight );
     const auto textOptions = skinnable()->textOptionsHint( subControl() );
 
 #if 0
@@ -150,8 +150,6 @@ QSizeF QskSubcontrolLayoutEngine::TextElement::implicitSize( const QSizeF& const
 
     QSizeF hint;
 
-    const qreal lineHeight = QFontMetricsF( font ).height();
-
     if ( m_text.isEmpty() )
     {
         if ( constraint.height() < 0.0 )
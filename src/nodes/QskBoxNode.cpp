@@ -6,6 +6,7 @@
 #include "QskBoxNode.h"
 #include "QskBoxShadowNode.h"
 #include "QskBoxRectangleNode.h"
+#include "QskBoxSdfNode.h"
 #include "QskSGNode.h"
 
 #include "QskGradient.h"
@@ -22,6 +23,7 @@ namespace
     {
         ShadowRole,
         ShadowFillRole,
+        SdfBoxRole,
         BoxRole,
         FillRole
     };
@@ -30,7 +32,7 @@ namespace
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
     static const QVector< quint8 > roles =
-        { ShadowRole, ShadowFillRole, BoxRole, FillRole };
+        { ShadowRole, ShadowFillRole, SdfBoxRole, BoxRole, FillRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -69,6 +71,7 @@ void QskBoxNode::updateNode( const QQuickWindow* window, const QRectF& rect,
 
     QskBoxShadowNode* shadowNode = nullptr;
     QskBoxRectangleNode* shadowFillNode = nullptr;
+    QskBoxSdfNode* sdfNode = nullptr;
     QskBoxRectangleNode* rectNode = nullptr;
     QskBoxRectangleNode* fillNode = nullptr;
 
@@ -111,7 +114,18 @@ void QskBoxNode::updateNode( const QQuickWindow* window, const QRectF& rect,
             }
         }
 
-        if ( hasBorder || hasFilling )
+        if ( ( hasBorder || hasFilling ) && QskBoxSdfNode::isSupported(
+            rect, shapeMetrics, borderMetrics, borderColors, gradient ) )
+        {
+            /*
+                Rounded corners are done by a shader, instead of
+                creating contour lines for them.
+             */
+            sdfNode = qskNode< QskBoxSdfNode >( this, SdfBoxRole );
+            sdfNode->updateNode( window, rect,
+                shapeMetrics, borderMetrics, borderColors, gradient );
+        }
+        else if ( hasBorder || hasFilling )
         {
             rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
 
@@ -142,6 +156,7 @@ void QskBoxNode::updateNode( const QQuickWindow* window, const QRectF& rect,
 
     qskUpdateChildren( this, ShadowRole, shadowNode );
     qskUpdateChildren( this, ShadowFillRole, shadowFillNode );
+    qskUpdateChildren( this, SdfBoxRole, sdfNode );
     qskUpdateChildren( this, BoxRole, rectNode );
     qskUpdateChildren( this, FillRole, fillNode );
 }
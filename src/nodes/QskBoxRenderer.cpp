@@ -15,6 +15,10 @@
 #include "QskGradientDirection.h"
 #include "QskFunctions.h"
 
+#include <qcache.h>
+#include <qglobalstatic.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
 #include <qsggeometry.h>
 
 static inline QskVertex::Line* qskAllocateLines(
@@ -70,6 +74,159 @@ static inline bool qskMaybeSpreading( const QskGradient& gradient )
     return true;
 }
 
+namespace
+{
+    /*
+        Boxes with the same metrics/colors - f.e the buttons in a grid - result
+        in the same contour lines, only translated. Calculating lines for the
+        rounded corners is way more expensive than translating the points of
+        the lines, so we keep the lines of the boxes we have seen recently.
+     */
+
+    class GeometryKey
+    {
+      public:
+        enum Type : quint8
+        {
+            Invalid,
+
+            BorderLines,
+            FillLines,
+            ColoredBorderLines,
+            ColoredBorderAndFillLines
+        };
+
+        GeometryKey( Type type, const QQuickWindow* window,
+                const QRectF& rect, const QskBoxShapeMetrics& shape,
+                const QskBoxBorderMetrics& border,
+                const QskBoxBorderColors& borderColors = QskBoxBorderColors(),
+                const QskGradient& gradient = QskGradient() )
+            : type( type )
+            , size( rect.size() )
+            , shape( shape )
+            , border( border )
+            , borderColors( borderColors )
+            , gradient( gradient )
+        {
+            if ( window )
+                devicePixelRatio = window->effectiveDevicePixelRatio();
+
+            if ( shape.toAbsolute( size ).isRectangle() )
+            {
+                // only a few lines: not worth the effort
+                this->type = Invalid;
+            }
+
+            if ( gradient.isVisible() && !gradient.isMonochrome()
+                && ( gradient.stretchMode() != QskGradient::StretchToSize ) )
+            {
+                // the colors depend on the position of the box
+                this->type = Invalid;
+            }
+        }
+
+        inline bool isValid() const { return type != Invalid; }
+
+        inline bool operator==( const GeometryKey& other ) const
+        {
+            return ( type == other.type ) && ( size == other.size )
+                && ( devicePixelRatio == other.devicePixelRatio )
+                && ( shape == other.shape ) && ( border == other.border )
+                && ( borderColors == other.borderColors )
+                && ( gradient == other.gradient );
+        }
+
+        Type type;
+
+        QSizeF size;
+        qreal devicePixelRatio = 1.0;
+
+        QskBoxShapeMetrics shape;
+        QskBoxBorderMetrics border;
+        QskBoxBorderColors borderColors;
+        QskGradient gradient;
+    };
+
+    inline QskHashValue qHash( const GeometryKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = ::qHash( int( key.type ), seed );
+        hash = qHashBits( &key.size, sizeof( key.size ), hash );
+        hash = key.shape.hash( hash );
+        hash = key.border.hash( hash );
+        hash = key.borderColors.hash( hash );
+        hash = key.gradient.hash( hash );
+
+        return hash;
+    }
+
+    class GeometryCache
+    {
+      public:
+        GeometryCache()
+            : m_cache( 2 * 1024 * 1024 ) // bytes
+        {
+        }
+
+        bool restore( const GeometryKey& key,
+            const QRectF& rect, QSGGeometry& geometry )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            const auto vertexData = m_cache.object( key );
+            if ( vertexData == nullptr )
+                return false;
+
+            const int stride = geometry.sizeOfVertex();
+
+            geometry.allocate( vertexData->size() / stride );
+            memcpy( geometry.vertexData(), vertexData->constData(), vertexData->size() );
+
+            translate( static_cast< char* >( geometry.vertexData() ),
+                geometry.vertexCount(), stride, rect.x(), rect.y() );
+
+            return true;
+        }
+
+        void store( const GeometryKey& key,
+            const QRectF& rect, const QSGGeometry& geometry )
+        {
+            const int stride = geometry.sizeOfVertex();
+            const int bytes = geometry.vertexCount() * stride;
+
+            auto vertexData = new QByteArray(
+                static_cast< const char* >( geometry.vertexData() ), bytes );
+
+            translate( vertexData->data(),
+                geometry.vertexCount(), stride, -rect.x(), -rect.y() );
+
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, vertexData, bytes );
+        }
+
+      private:
+        static void translate( char* data,
+            int vertexCount, int stride, qreal dx, qreal dy )
+        {
+            if ( dx == 0.0 && dy == 0.0 )
+                return;
+
+            // all vertex types start with x/y as floats
+            for ( int i = 0; i < vertexCount; i++ )
+            {
+                auto point = reinterpret_cast< float* >( data + i * stride );
+
+                point[0] += dx;
+                point[1] += dy;
+            }
+        }
+
+        QMutex m_mutex;
+        QCache< GeometryKey, QByteArray > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( GeometryCache, qskGeometryCache )
+
 QskBoxRenderer::QskBoxRenderer( const QQuickWindow* window )
     : m_window( window )
 {
@@ -125,12 +282,19 @@ void QskBoxRenderer::setBorderLines(
     geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
     geometry.markVertexDataDirty();
 
+    const GeometryKey key( GeometryKey::BorderLines, m_window, rect, shape, border );
+    if ( key.isValid() && qskGeometryCache->restore( key, rect, geometry ) )
+        return;
+
     const QskBoxMetrics metrics( rect, shape, border );
     const QskBoxBasicStroker stroker( metrics );
 
     const auto lines = qskAllocateLines( geometry, stroker.borderCount() );
     if ( lines )
         stroker.setBorderLines( lines );
+
+    if ( key.isValid() )
+        qskGeometryCache->store( key, rect, geometry );
 }
 
 void QskBoxRenderer::setFillLines(
@@ -146,11 +310,18 @@ void QskBoxRenderer::setFillLines(
     geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
     geometry.markVertexDataDirty();
 
+    const GeometryKey key( GeometryKey::FillLines, m_window, rect, shape, border );
+    if ( key.isValid() && qskGeometryCache->restore( key, rect, geometry ) )
+        return;
+
     const QskBoxMetrics metrics( rect, shape, border );
     QskBoxBasicStroker stroker( metrics );
 
     if ( auto lines = qskAllocateLines( geometry, stroker.fillCount() ) )
         stroker.setFillLines( lines );
+
+    if ( key.isValid() )
+        qskGeometryCache->store( key, rect, geometry );
 }
 
 void QskBoxRenderer::setColoredFillLines( const QRectF& rect,
@@ -168,11 +339,20 @@ void QskBoxRenderer::setColoredBorderLines( const QRectF& rect,
     geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
     geometry.markVertexDataDirty();
 
+    const GeometryKey key( GeometryKey::ColoredBorderLines,
+        m_window, rect, shape, border, borderColors );
+
+    if ( key.isValid() && qskGeometryCache->restore( key, rect, geometry ) )
+        return;
+
     const QskBoxMetrics metrics( rect, shape, border );
     const QskBoxBasicStroker stroker( metrics, borderColors );
 
     if ( auto lines = qskAllocateColoredLines( geometry, stroker.borderCount() ) )
         stroker.setBoxLines( lines, nullptr );
+
+    if ( key.isValid() )
+        qskGeometryCache->store( key, rect, geometry );
 }
 
 void QskBoxRenderer::setColoredBorderAndFillLines( const QRectF& rect,
@@ -183,6 +363,12 @@ void QskBoxRenderer::setColoredBorderAndFillLines( const QRectF& rect,
     geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
     geometry.markVertexDataDirty();
 
+    const GeometryKey key( GeometryKey::ColoredBorderAndFillLines,
+        m_window, rect, shape, border, borderColors, gradient );
+
+    if ( key.isValid() && qskGeometryCache->restore( key, rect, geometry ) )
+        return;
+
     const QskBoxMetrics metrics( rect, shape, border );
     const auto effectiveGradient = qskEffectiveGradient( metrics.innerRect, gradient );
 
@@ -241,6 +427,9 @@ void QskBoxRenderer::setColoredBorderAndFillLines( const QRectF& rect,
             l[0].p2 = l[+1].p1;
         }
     }
+
+    if ( key.isValid() )
+        qskGeometryCache->store( key, rect, geometry );
 }
 
 QskGradient QskBoxRenderer::effectiveGradient( const QskGradient& gradient )
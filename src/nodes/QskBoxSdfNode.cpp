@@ -0,0 +1,511 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxSdfNode.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxRenderer.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskVertex.h"
+
+#include <qcolor.h>
+#include <qquickwindow.h>
+#include <qsgmaterialshader.h>
+#include <qsgmaterial.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using RhiShader = QSGMaterialRhiShader;
+#else
+    using RhiShader = QSGMaterialShader;
+#endif
+
+static inline bool qskHasBorder(
+    const QskBoxBorderMetrics& metrics, const QskBoxBorderColors& colors )
+{
+    return !metrics.isNull() && colors.isVisible();
+}
+
+static inline bool qskIsSdfEnabled()
+{
+    extern bool qskHasEnvironment( const char* );
+    return qskHasEnvironment( "QSK_SDF_BOXES" );
+}
+
+namespace
+{
+    /*
+        The parameters of the box are passed as vertex attributes instead
+        of uniforms. Then all boxes share the same material and can be
+        merged into one batch - like the geometries of QskBoxRectangleNode.
+     */
+    class Vertex
+    {
+      public:
+        float x, y;
+
+        // position relative to the center of the box and its half size
+        float cx, cy, w2, h2;
+
+        // bottom-right, top-right, bottom-left, top-left
+        float radius[4];
+
+        // start point and normalized gradient vector
+        float gradient[4];
+
+        float borderWidth;
+        float pixelSize;
+
+        // fragments with less coverage are discarded
+        float coverageLimit;
+
+        QskVertex::Color fillColor1;
+        QskVertex::Color fillColor2;
+        QskVertex::Color borderColor;
+    };
+
+    static_assert( sizeof( Vertex ) == 80, "Unexpected padding" );
+
+    const QSGGeometry::AttributeSet& attributeSet()
+    {
+        /*
+            8 attributes is the minimum for GL_MAX_VERTEX_ATTRIBS, that
+            has to be supported by OpenGL ES 2.0. So we are at the limit
+            and additional parameters have to be packed into the existing
+            attributes - like coverageLimit into the metrics.
+         */
+        using A = QSGGeometry::Attribute;
+
+        static const A attributes[] =
+        {
+            A::createWithAttributeType( 0, 2, QSGGeometry::FloatType, A::PositionAttribute ),
+            A::createWithAttributeType( 1, 4, QSGGeometry::FloatType, A::TexCoordAttribute ),
+            A::createWithAttributeType( 2, 4, QSGGeometry::FloatType, A::UnknownAttribute ),
+            A::createWithAttributeType( 3, 4, QSGGeometry::FloatType, A::UnknownAttribute ),
+            A::createWithAttributeType( 4, 3, QSGGeometry::FloatType, A::UnknownAttribute ),
+            A::createWithAttributeType( 5, 4, QSGGeometry::UnsignedByteType, A::ColorAttribute ),
+            A::createWithAttributeType( 6, 4, QSGGeometry::UnsignedByteType, A::ColorAttribute ),
+            A::createWithAttributeType( 7, 4, QSGGeometry::UnsignedByteType, A::ColorAttribute )
+        };
+
+        static const QSGGeometry::AttributeSet attributeSet =
+            { 8, sizeof( Vertex ), attributes };
+
+        return attributeSet;
+    }
+
+    class Material final : public QSGMaterial
+    {
+      public:
+        Material();
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+        QSGMaterialType* type() const override;
+
+        int compare( const QSGMaterial* other ) const override;
+
+        bool setOpaque( bool );
+        bool isOpaque() const;
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderFileName( VertexStage, root + "boxsdf.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "boxsdf.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            Q_ASSERT( state.uniformData()->size() >= 68 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 64, &opacity, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "boxsdf.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "boxsdf.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] =
+            {
+                "in_vertex", "in_coord", "in_radius", "in_gradient", "in_metrics",
+                "in_fillColor1", "in_fillColor2", "in_borderColor", nullptr
+            };
+
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            auto p = program();
+
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_opacityId = p->uniformLocation( "opacity" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            auto p = program();
+
+            if ( state.isMatrixDirty() )
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+            if ( state.isOpacityDirty() )
+                p->setUniformValue( m_opacityId, state.opacity() );
+        }
+
+      private:
+        int m_matrixId = -1;
+        int m_opacityId = -1;
+    };
+}
+
+#endif
+
+Material::Material()
+{
+    setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+QSGMaterialType* Material::type() const
+{
+    static QSGMaterialType staticType;
+    return &staticType;
+}
+
+int Material::compare( const QSGMaterial* other ) const
+{
+    // all parameters are vertex attributes
+    const auto mat = static_cast< const Material* >( other );
+    return int( isOpaque() ) - int( mat->isOpaque() );
+}
+
+bool Material::setOpaque( bool on )
+{
+    if ( on == isOpaque() )
+        return false;
+
+    setFlag( QSGMaterial::Blending, !on );
+    return true;
+}
+
+bool Material::isOpaque() const
+{
+    return !( flags() & QSGMaterial::Blending );
+}
+
+class QskBoxSdfNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskBoxSdfNodePrivate()
+        : geometry( attributeSet(), 4, 6 )
+    {
+        geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+
+        static const quint16 indices[] = { 0, 1, 2, 2, 1, 3 };
+        memcpy( geometry.indexDataAsUShort(), indices, sizeof( indices ) );
+    }
+
+    QSGGeometry geometry;
+    Material material;
+};
+
+QskBoxSdfNode::QskBoxSdfNode()
+    : QSGGeometryNode( *new QskBoxSdfNodePrivate )
+{
+    Q_D( QskBoxSdfNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+}
+
+QskBoxSdfNode::~QskBoxSdfNode()
+{
+}
+
+void QskBoxSdfNode::updateNode( const QQuickWindow* window, const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    Q_D( QskBoxSdfNode );
+
+    Vertex v;
+
+    /*
+        The antialiasing is done for one device pixel, what is not
+        correct for items being scaled. But the same is true for the
+        contour lines of QskBoxRectangleNode.
+     */
+    v.pixelSize = 1.0 / window->effectiveDevicePixelRatio();
+
+    v.w2 = 0.5 * rect.width();
+    v.h2 = 0.5 * rect.height();
+
+    {
+        const auto shape = shapeMetrics.toAbsolute( rect.size() );
+
+        v.radius[0] = shape.radius( Qt::BottomRightCorner ).width();
+        v.radius[1] = shape.radius( Qt::TopRightCorner ).width();
+        v.radius[2] = shape.radius( Qt::BottomLeftCorner ).width();
+        v.radius[3] = shape.radius( Qt::TopLeftCorner ).width();
+    }
+
+    v.borderWidth = 0.0;
+    v.borderColor = QskVertex::Color( 0, 0, 0, 0 );
+
+    if ( qskHasBorder( borderMetrics, borderColors ) )
+    {
+        v.borderWidth = borderMetrics.toAbsolute( rect.size() ).widthAt( Qt::TopEdge );
+        v.borderColor = QskVertex::Color( borderColors.left().rgbStart() );
+    }
+
+    v.fillColor1 = v.fillColor2 = QskVertex::Color( 0, 0, 0, 0 );
+
+    for ( auto& value : v.gradient )
+        value = 0.0;
+
+    if ( gradient.isVisible() )
+    {
+        if ( gradient.isMonochrome() )
+        {
+            v.fillColor1 = v.fillColor2 = QskVertex::Color( gradient.rgbStart() );
+        }
+        else
+        {
+            auto g = QskBoxRenderer::effectiveGradient( gradient );
+
+            if ( g.stretchMode() == QskGradient::StretchToSize )
+            {
+                const qreal bw = v.borderWidth;
+                g.stretchTo( rect.adjusted( bw, bw, -bw, -bw ) );
+            }
+
+            const auto& stops = g.stops();
+
+            v.fillColor1 = QskVertex::Color( stops.first().rgb() );
+            v.fillColor2 = QskVertex::Color( stops.last().rgb() );
+
+            const auto vector = g.linearDirection().vector();
+
+            const qreal dx = vector.dx();
+            const qreal dy = vector.dy();
+            const qreal length2 = dx * dx + dy * dy;
+
+            if ( length2 > 0.0 )
+            {
+                const auto center = rect.center();
+
+                v.gradient[0] = vector.x1() - center.x();
+                v.gradient[1] = vector.y1() - center.y();
+                v.gradient[2] = dx / length2;
+                v.gradient[3] = dy / length2;
+            }
+        }
+    }
+
+    /*
+        The quad has some extra space for the antialiasing. As it depends
+        on the device pixel ratio the vertices are always recalculated
+        and compared with the current ones.
+     */
+    const float m = v.pixelSize;
+
+    const float x1 = rect.left() - m;
+    const float y1 = rect.top() - m;
+    const float x2 = rect.right() + m;
+    const float y2 = rect.bottom() + m;
+
+    /*
+        Without blending the antialiased outline of the box would
+        end up as a dark fringe. So opaque boxes cut off their
+        outline at the half covered fragments, trading the antialiasing
+        for being drawn in the opaque pass of the renderer.
+     */
+    const bool isOpaque = ( v.fillColor1.a == 255 ) && ( v.fillColor2.a == 255 )
+        && ( v.borderWidth <= 0.0 || v.borderColor.a == 255 );
+
+    v.coverageLimit = isOpaque ? 0.5 : 0.0;
+
+    if ( d->material.setOpaque( isOpaque ) )
+        markDirty( QSGNode::DirtyMaterial );
+
+    Vertex vertices[4] = { v, v, v, v };
+
+    auto& v0 = vertices[0];
+    v0.x = x1;
+    v0.y = y1;
+    v0.cx = -v.w2 - m;
+    v0.cy = -v.h2 - m;
+
+    auto& v1 = vertices[1];
+    v1.x = x2;
+    v1.y = y1;
+    v1.cx = v.w2 + m;
+    v1.cy = -v.h2 - m;
+
+    auto& v2 = vertices[2];
+    v2.x = x1;
+    v2.y = y2;
+    v2.cx = -v.w2 - m;
+    v2.cy = v.h2 + m;
+
+    auto& v3 = vertices[3];
+    v3.x = x2;
+    v3.y = y2;
+    v3.cx = v.w2 + m;
+    v3.cy = v.h2 + m;
+
+    auto vertexData = d->geometry.vertexData();
+
+    if ( memcmp( vertexData, vertices, sizeof( vertices ) ) != 0 )
+    {
+        memcpy( vertexData, vertices, sizeof( vertices ) );
+
+        d->geometry.markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+}
+
+bool QskBoxSdfNode::isSupported( const QRectF& rect,
+    const QskBoxShapeMetrics& shapeMetrics, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    static const bool isEnabled = qskIsSdfEnabled();
+
+    if ( !isEnabled || rect.isEmpty() )
+        return false;
+
+    const auto shape = shapeMetrics.toAbsolute( rect.size() );
+    if ( shape.isRectangle() )
+        return false;
+
+    {
+        const auto maxRadius = 0.5 * qMin( rect.width(), rect.height() );
+
+        for ( int i = Qt::TopLeftCorner; i <= Qt::BottomRightCorner; i++ )
+        {
+            const auto radius = shape.radius( static_cast< Qt::Corner >( i ) );
+
+            if ( !qFuzzyCompare( radius.width(), radius.height() )
+                || ( radius.width() > maxRadius ) )
+            {
+                // elliptic or overlapping corners
+                return false;
+            }
+        }
+    }
+
+    if ( qskHasBorder( borderMetrics, borderColors ) )
+    {
+        const auto border = borderMetrics.toAbsolute( rect.size() );
+
+        if ( !border.widths().isEquidistant() || !borderColors.isMonochrome() )
+            return false;
+    }
+
+    if ( gradient.isVisible() && !gradient.isMonochrome() )
+    {
+        const auto g = QskBoxRenderer::effectiveGradient( gradient );
+
+        if ( ( g.type() != QskGradient::Linear )
+            || ( g.spreadMode() != QskGradient::PadSpread ) )
+        {
+            return false;
+        }
+
+        const auto& stops = g.stops();
+
+        if ( ( stops.count() != 2 ) || ( stops[ 0 ].position() != 0.0 )
+            || ( stops[ 1 ].position() != 1.0 ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOX_SDF_NODE_H
+#define QSK_BOX_SDF_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+class QQuickWindow;
+
+class QskBoxSdfNodePrivate;
+
+/*
+    A rounded box, with border and filling, that is drawn from a single quad
+    by a shader evaluating a signed distance function. In opposite to the
+    contour lines of QskBoxRectangleNode the geometry does not depend on
+    the radii, what makes it a good fit for size/shape animations.
+
+    The parameters of the box are vertex attributes, so that all
+    nodes share the same material and can be batched. The 8 attributes
+    are the minimum, that has to be supported by OpenGL ES 2.0.
+
+    Boxes with opaque colors are drawn without blending. Then the outline
+    is not antialiased.
+
+    Only a subset of what can be done with QskBoxRectangleNode is supported:
+    see isSupported().
+ */
+class QSK_EXPORT QskBoxSdfNode : public QSGGeometryNode
+{
+  public:
+    QskBoxSdfNode();
+    ~QskBoxSdfNode() override;
+
+    void updateNode( const QQuickWindow*, const QRectF&,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+    /*
+        Circular corners, a border of the same width and color
+        on all sides and a monochrome or simple linear gradient.
+        Plain rectangles are not supported, as they are a single quad
+        with QskBoxRectangleNode anyway - one that can be batched.
+
+        The node is disabled unless the environment variable
+        QSK_SDF_BOXES is set.
+     */
+    static bool isSupported( const QRectF&,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+  private:
+    Q_DECLARE_PRIVATE( QskBoxSdfNode )
+};
+
+#endif
@@ -12,84 +12,261 @@ QSK_QT_PRIVATE_BEGIN
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+#include <limits>
+
+/*
+    Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
+    seem to use 256 colors only ( according to maybe outdated sources
+    from the internet ). As all ramps of the atlas have the same
+    width we use 1024 to be on the safe side.
+ */
+static const int qskRampWidth = 1024;
+
+static int qskMaximumRampCount = 256;
 
 namespace
 {
-    class Texture : public QSGPlainTexture
+    class StopsKey
     {
       public:
-        Texture( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+        StopsKey() = default;
+
+        StopsKey( const QskGradientStops& stops )
+            : stops( stops )
+            , hash( 14000 )
         {
-            /*
-                Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
-                seem to use 256 colors only ( according to maybe outdated sources
-                from the internet ),
-             */
+            for ( const auto& stop : stops )
+            {
+                hash = qHash( stop.position(), hash );
+                hash = qHash( stop.rgb(), hash );
+            }
+        }
 
-            const int size = qBound( 256, 2 * stops.count(), 1024 );
-            setImage( QskRgb::colorTable( size, stops ) );
+        inline bool operator==( const StopsKey& other ) const
+        {
+            return ( hash == other.hash ) && ( stops == other.stops );
+        }
 
-            const auto wrapMode = this->wrapMode( spreadMode );
+        QskGradientStops stops;
+        QskHashValue hash = 0;
+    };
 
-            setHorizontalWrapMode( wrapMode );
-            setVerticalWrapMode( wrapMode );
+    inline QskHashValue qHash( const StopsKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
 
+    // the number of materials, that are using a color ramp
+    using References = QHash< StopsKey, int >;
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    using TextureBase = QSGTexture;
+#else
+    using TextureBase = QSGPlainTexture;
+#endif
+
+    /*
+        QSGPlainTexture uploads the complete image, whenever it has been
+        modified. As adding a ramp modifies one row only, we upload the
+        modified rows with Qt6. For the Qt5 APIs we stick to
+        QSGPlainTexture and upload the complete image.
+     */
+    class RampTexture final : public TextureBase
+    {
+      public:
+        RampTexture()
+        {
             setFiltering( QSGTexture::Linear );
+            setHorizontalWrapMode( QSGTexture::ClampToEdge );
+            setVerticalWrapMode( QSGTexture::ClampToEdge );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+            setHasAlphaChannel( true );
+#endif
         }
 
-      private:
-        static inline QSGTexture::WrapMode wrapMode( QskGradient::SpreadMode spreadMode )
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+        ~RampTexture() override
         {
-            switch ( spreadMode )
+            delete m_rhiTexture;
+        }
+
+        qint64 comparisonKey() const override
+        {
+            return qint64( quintptr( this ) );
+        }
+
+        QRhiTexture* rhiTexture() const override
+        {
+            return m_rhiTexture;
+        }
+
+        QSize textureSize() const override
+        {
+            return m_image.size();
+        }
+
+        bool hasAlphaChannel() const override
+        {
+            return true;
+        }
+
+        bool hasMipmaps() const override
+        {
+            return false;
+        }
+
+        void commitTextureOperations(
+            QRhi* rhi, QRhiResourceUpdateBatch* batch ) override
+        {
+            if ( m_rhiTexture && m_rhiTexture->pixelSize() != m_image.size() )
+            {
+                /*
+                    The atlas has grown. Draw calls of the current frame,
+                    that have been prepared before, are bound to the
+                    previous texture and are using texture coordinates
+                    for its size. So it has to stay alive until the
+                    frame has been submitted.
+                 */
+                m_rhiTexture->deleteLater();
+                m_rhiTexture = nullptr;
+            }
+
+            if ( m_rhiTexture == nullptr )
             {
-                case QskGradient::RepeatSpread:
-                    return QSGTexture::Repeat;
+                m_rhiTexture = rhi->newTexture( QRhiTexture::RGBA8, m_image.size() );
+                if ( !m_rhiTexture->create() )
+                {
+                    delete m_rhiTexture;
+                    m_rhiTexture = nullptr;
 
-                case QskGradient::ReflectSpread:
-                    return QSGTexture::MirroredRepeat;
+                    return;
+                }
 
-                default:
-                    return QSGTexture::ClampToEdge;
+                setRowsDirty( 0, m_image.height() - 1 );
+            }
+
+            if ( m_dirtyFrom <= m_dirtyTo )
+            {
+                /*
+                    Uploading a copy of the modified rows, so that
+                    m_image does not need to be detached, when adding
+                    more rows before the batch has been submitted.
+                 */
+                const int rowCount = m_dirtyTo - m_dirtyFrom + 1;
+
+                QRhiTextureSubresourceUploadDescription description(
+                    m_image.copy( 0, m_dirtyFrom, m_image.width(), rowCount ) );
+                description.setDestinationTopLeft( QPoint( 0, m_dirtyFrom ) );
+
+                batch->uploadTexture( m_rhiTexture,
+                    QRhiTextureUploadEntry( 0, 0, description ) );
+
+                m_dirtyFrom = std::numeric_limits< int >::max();
+                m_dirtyTo = -1;
             }
         }
+#else
+        void sync()
+        {
+            if ( m_dirtyFrom <= m_dirtyTo )
+            {
+                setImage( m_image );
+
+                m_dirtyFrom = std::numeric_limits< int >::max();
+                m_dirtyTo = -1;
+            }
+        }
+#endif
+
+        void setRowCount( int count )
+        {
+            QImage image( qskRampWidth, count, QImage::Format_RGBA8888_Premultiplied );
+            image.fill( Qt::transparent );
+
+            for ( int i = 0; i < qMin( m_image.height(), count ); i++ )
+                memcpy( image.scanLine( i ), m_image.constScanLine( i ), qskRampWidth * 4 );
+
+            m_image = image;
+            setRowsDirty( 0, count - 1 );
+        }
+
+        uint* rowData( int index )
+        {
+            setRowsDirty( index, index );
+            return reinterpret_cast< uint* >( m_image.scanLine( index ) );
+        }
+
+      private:
+        inline void setRowsDirty( int from, int to )
+        {
+            m_dirtyFrom = qMin( m_dirtyFrom, from );
+            m_dirtyTo = qMax( m_dirtyTo, to );
+        }
+
+        QImage m_image;
+
+        int m_dirtyFrom = std::numeric_limits< int >::max();
+        int m_dirtyTo = -1;
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+        QRhiTexture* m_rhiTexture = nullptr;
+#endif
     };
 
-    class HashKey
+    class Atlas
     {
       public:
-        inline bool operator==( const HashKey& other ) const
+        Atlas()
+            : texture( new RampTexture() )
         {
-            return rhi == other.rhi && spreadMode == other.spreadMode && stops == other.stops;
         }
 
-        const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
-    };
+        ~Atlas()
+        {
+            delete texture;
+        }
 
-    inline size_t qHash( const HashKey& key, size_t seed = 0 )
-    {
-        size_t values = seed + key.spreadMode;
+        int row( const QskGradientStops&, const References& );
 
-        for ( const auto& stop : key.stops )
-            values += stop.rgb();
+        RampTexture* texture;
+        QskColorRamp::Statistics statistics;
 
-        return values;
-    }
+      private:
+        int allocateRow( const References& );
+        void setRowCount( int );
+
+        class Row
+        {
+          public:
+            StopsKey key;
+            quint64 lastUsage = 0;
+        };
+
+        QHash< StopsKey, int > m_rowIndexes;
+        QVector< Row > m_rows;
+
+        quint64 m_usage = 0;
+    };
 
     class Cache
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        ~Cache() { qDeleteAll( m_atlases ); }
 
         void cleanupRhi( const QRhi* );
 
-        Texture* texture( const void* rhi,
-            const QskGradientStops&, QskGradient::SpreadMode );
+        Atlas* atlas( const void* rhi );
+        const Atlas* atlas( const void* rhi ) const;
+
+        QMutex mutex;
+        References references;
 
       private:
-        QHash< HashKey, Texture* > m_hashTable;
-        QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
+        QHash< const void*, Atlas* > m_atlases; // usually only one entry
     };
 
     static Cache* s_cache;
@@ -107,52 +284,124 @@ static void qskCleanupRhi( const QRhi* rhi )
         s_cache->cleanupRhi( rhi );
 }
 
-Texture* Cache::texture( const void* rhi,
-    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+int Atlas::row( const QskGradientStops& stops, const References& references )
 {
-    const HashKey key { rhi, stops, spreadMode };
+    const StopsKey key( stops );
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    const auto it = m_rowIndexes.constFind( key );
+    if ( it != m_rowIndexes.constEnd() )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        statistics.hits++;
+        m_rows[ it.value() ].lastUsage = ++m_usage;
 
-        if ( rhi != nullptr )
-        {
-            auto myrhi = ( QRhi* )rhi;
+        return it.value();
+    }
 
-            if ( !m_rhiTable.contains( myrhi ) )
-            {
-                myrhi->addCleanupCallback( qskCleanupRhi );
-                m_rhiTable += myrhi;
-            }
-        }
+    statistics.misses++;
+
+    const int index = allocateRow( references );
+
+    auto& row = m_rows[ index ];
+    row.key = key;
+    row.lastUsage = ++m_usage;
+
+    m_rowIndexes.insert( key, index );
+
+    QskRgb::colorTable( qskRampWidth, stops, texture->rowData( index ) );
+
+    statistics.rampCount = m_rowIndexes.count();
+
+    return index;
+}
+
+int Atlas::allocateRow( const References& references )
+{
+    if ( m_rowIndexes.count() < m_rows.count() )
+    {
+        // a row, that has never been used
+        return m_rowIndexes.count();
     }
 
-    return texture;
+    const int maxCount = qMax( qskMaximumRampCount, 1 );
+
+    if ( m_rows.count() < maxCount )
+    {
+        const int index = m_rows.count();
+        setRowCount( qMin( qMax( 2 * m_rows.count(), 16 ), maxCount ) );
+
+        return index;
+    }
+
+    /*
+        Recycling the least recently used row, that is not in use by any
+        material. Rows of the materials might be rendered in the current
+        frame, so we have to grow beyond maximumRampCount(), when all
+        of them are in use.
+     */
+    int index = -1;
+    for ( int i = 0; i < m_rows.count(); i++ )
+    {
+        const auto& row = m_rows[ i ];
+
+        if ( index >= 0 && row.lastUsage >= m_rows[ index ].lastUsage )
+            continue;
+
+        if ( !references.contains( row.key ) )
+            index = i;
+    }
+
+    if ( index < 0 )
+    {
+        index = m_rows.count();
+        setRowCount( 2 * m_rows.count() );
+
+        return index;
+    }
+
+    m_rowIndexes.remove( m_rows[ index ].key );
+    statistics.evictions++;
+
+    return index;
 }
 
-void Cache::cleanupRhi( const QRhi* rhi )
+void Atlas::setRowCount( int count )
 {
-    for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); )
+    m_rows.resize( count );
+    texture->setRowCount( count );
+
+    statistics.rowCount = count;
+    statistics.bytes = qint64( qskRampWidth ) * count * 4;
+}
+
+Atlas* Cache::atlas( const void* rhi )
+{
+    auto& atlas = m_atlases[ rhi ];
+    if ( atlas == nullptr )
     {
-        if ( it.key().rhi == rhi )
-        {
-            delete it.value();
-            it = m_hashTable.erase( it );
-        }
-        else
+        atlas = new Atlas();
+
+        if ( rhi != nullptr )
         {
-            ++it;
+            auto myrhi = ( QRhi* )rhi;
+            myrhi->addCleanupCallback( qskCleanupRhi );
         }
     }
 
-    m_rhiTable.removeAll( rhi );
+    return atlas;
 }
 
-QSGTexture* QskColorRamp::texture( const void* rhi,
-    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+const Atlas* Cache::atlas( const void* rhi ) const
+{
+    return m_atlases.value( rhi, nullptr );
+}
+
+void Cache::cleanupRhi( const QRhi* rhi )
+{
+    QMutexLocker locker( &mutex );
+    delete m_atlases.take( rhi );
+}
+
+static inline Cache* qskCache()
 {
     if ( s_cache == nullptr )
     {
@@ -167,5 +416,85 @@ QSGTexture* QskColorRamp::texture( const void* rhi,
         qAddPostRoutine( qskCleanupCache );
     }
 
-    return s_cache->texture( rhi, stops, spreadMode );
+    return s_cache;
+}
+
+QskColorRamp::Ramp QskColorRamp::ramp( const void* rhi,
+    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+
+    auto atlas = cache->atlas( rhi );
+    const int row = atlas->row( stops, cache->references );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    atlas->texture->sync();
+#endif
+
+    Ramp ramp;
+    ramp.texture = atlas->texture;
+    ramp.coordinates = QVector2D(
+        ( row + 0.5f ) / atlas->statistics.rowCount, spreadMode );
+
+    return ramp;
+}
+
+QSGTexture* QskColorRamp::texture( const void* rhi )
+{
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    return cache->atlas( rhi )->texture;
+}
+
+void QskColorRamp::addReference( const QskGradientStops& stops )
+{
+    if ( stops.isEmpty() )
+        return;
+
+    auto cache = qskCache();
+
+    QMutexLocker locker( &cache->mutex );
+    cache->references[ StopsKey( stops ) ]++;
+}
+
+void QskColorRamp::removeReference( const QskGradientStops& stops )
+{
+    if ( stops.isEmpty() || s_cache == nullptr )
+        return;
+
+    QMutexLocker locker( &s_cache->mutex );
+
+    auto& references = s_cache->references;
+
+    auto it = references.find( StopsKey( stops ) );
+    if ( it != references.end() && --it.value() <= 0 )
+        references.erase( it );
+}
+
+void QskColorRamp::setMaximumRampCount( int count )
+{
+    qskMaximumRampCount = qMax( count, 1 );
+}
+
+int QskColorRamp::maximumRampCount()
+{
+    return qskMaximumRampCount;
+}
+
+QskColorRamp::Statistics QskColorRamp::statistics( const void* rhi )
+{
+    if ( s_cache == nullptr )
+        return Statistics();
+
+    QMutexLocker locker( &s_cache->mutex );
+
+    const auto cache = static_cast< const Cache* >( s_cache );
+
+    if ( auto atlas = cache->atlas( rhi ) )
+        return atlas->statistics;
+
+    return Statistics();
 }
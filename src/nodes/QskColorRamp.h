@@ -9,12 +9,70 @@
 #include "QskGlobal.h"
 #include "QskGradient.h"
 
+#include <qvector2d.h>
+
 class QSGTexture;
 
+/*
+    The color ramps of the gradients are rows of an atlas texture,
+    that is shared by all gradient materials of the same RHI.
+
+    The spread mode is not a property of the texture, but has to be
+    implemented in the shader. So gradients, that differ in the spread
+    mode only, share the same row.
+
+    Rows are recycled in LRU order, when the number of color ramps
+    exceeds maximumRampCount(). Rows of ramps, that are referenced
+    by a material, are never recycled.
+
+    Sharing the texture avoids rebinding textures between gradients,
+    but the row is passed as uniform. Merging gradient materials into
+    one draw call would need the row and the gradient vector
+    as vertex attributes.
+ */
 namespace QskColorRamp
 {
-    QSGTexture* texture( const void* rhi,
+    class Ramp
+    {
+      public:
+        QSGTexture* texture = nullptr;
+
+        /*
+            x: texture coordinate of the row
+            y: spread mode
+         */
+        QVector2D coordinates;
+    };
+
+    class Statistics
+    {
+      public:
+        int rampCount = 0;
+        int rowCount = 0; // allocated rows of the atlas
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        qint64 bytes = 0;
+    };
+
+    Ramp ramp( const void* rhi,
         const QskGradientStops&, QskGradient::SpreadMode );
+
+    // the atlas texture, without looking up a ramp
+    QSGTexture* texture( const void* rhi );
+
+    // materials, that are using the ramp of the stops
+    void addReference( const QskGradientStops& );
+    void removeReference( const QskGradientStops& );
+
+    // default: 256
+    QSK_EXPORT void setMaximumRampCount( int );
+    QSK_EXPORT int maximumRampCount();
+
+    // nullptr for the Qt5/OpenGL path
+    QSK_EXPORT Statistics statistics( const void* rhi );
 }
 
 #endif
@@ -85,6 +85,7 @@ namespace
         {
             m_opacityId = program()->uniformLocation( "opacity" );
             m_matrixId = program()->uniformLocation( "matrix" );
+            m_rampId = program()->uniformLocation( "ramp" );
         }
 
         void updateState( const RenderState& state,
@@ -101,9 +102,11 @@ namespace
 
             updateUniformValues( material );
 
-            auto texture = QskColorRamp::texture(
+            const auto ramp = QskColorRamp::ramp(
                 nullptr, material->stops(), material->spreadMode() );
-            texture->bind();
+
+            p->setUniformValue( m_rampId, ramp.coordinates );
+            ramp.texture->bind();
         }
 
         char const* const* attributeNames() const override final
@@ -117,6 +120,7 @@ namespace
       protected:
         int m_opacityId = -1;
         int m_matrixId = -1;
+        int m_rampId = -1;
     };
 #endif
 
@@ -133,15 +137,16 @@ namespace
         }
 
         void updateSampledImage( RenderState& state, int binding,
-            QSGTexture* textures[], QSGMaterial* newMaterial, QSGMaterial* ) override final
+            QSGTexture* textures[], QSGMaterial*, QSGMaterial* ) override final
         {
             if ( binding != 1 )
                 return;
 
-            auto material = static_cast< const GradientMaterial* >( newMaterial );
-
-            auto texture = QskColorRamp::texture(
-                state.rhi(), material->stops(), material->spreadMode() );
+            /*
+                The ramp has been looked up in updateUniformData already,
+                all ramps are rows of the same atlas texture.
+             */
+            auto texture = QskColorRamp::texture( state.rhi() );
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
             texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
@@ -151,6 +156,39 @@ namespace
 
             textures[0] = texture;
         }
+
+      protected:
+        bool updateRamp( RenderState& state, const GradientMaterial* material )
+        {
+            /*
+                The row of the color ramp might change, when the atlas
+                is growing or rows are recycled. So we can't rely on
+                comparing the materials.
+
+                Coordinates, that have been passed for previous draw calls
+                of the same frame, do not become invalid, when the atlas
+                grows: a texture of a different size is created and the
+                previous one - with the layout of these coordinates - is
+                kept until the end of the frame ( see QskColorRamp ).
+                Rows in use are never recycled.
+
+                The row is a uniform, like the gradient vector. As both are
+                per material, gradient materials with different gradients
+                are not merged into one draw call.
+             */
+            const auto ramp = QskColorRamp::ramp(
+                state.rhi(), material->stops(), material->spreadMode() );
+
+            auto data = state.uniformData()->data() + 88;
+
+            if ( memcmp( data, &ramp.coordinates, 8 ) != 0 )
+            {
+                memcpy( data, &ramp.coordinates, 8 );
+                return true;
+            }
+
+            return false;
+        }
     };
 #endif
 }
@@ -175,12 +213,6 @@ namespace
                 changed = true;
             }
 
-            /*
-                When having a gradient, that does not need spreading
-                we could set QskGradient::PadSpread to potentally reduce
-                the number of color ramps. TODO ...
-             */
-
             if ( gradient.spreadMode() != spreadMode() )
             {
                 setSpreadMode( gradient.spreadMode() );
@@ -267,7 +299,7 @@ namespace
             auto matNew = static_cast< LinearMaterial* >( newMaterial );
             auto matOld = static_cast< LinearMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 96 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -294,6 +326,9 @@ namespace
                 changed = true;
             }
 
+            if ( updateRamp( state, matNew ) )
+                changed = true;
+
             return changed;
         }
     };
@@ -427,7 +462,7 @@ namespace
             auto matNew = static_cast< RadialMaterial* >( newMaterial );
             auto matOld = static_cast< RadialMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 96 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -460,6 +495,9 @@ namespace
                 changed = true;
             }
 
+            if ( updateRamp( state, matNew ) )
+                changed = true;
+
             return changed;
         }
     };
@@ -635,7 +673,7 @@ namespace
             auto matNew = static_cast< ConicMaterial* >( newMaterial );
             auto matOld = static_cast< ConicMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 88 );
+            Q_ASSERT( state.uniformData()->size() >= 96 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -680,6 +718,9 @@ namespace
                 changed = true;
             }
 
+            if ( updateRamp( state, matNew ) )
+                changed = true;
+
             return changed;
         }
     };
@@ -700,6 +741,20 @@ QskGradientMaterial::QskGradientMaterial( QskGradient::Type type )
 {
 }
 
+QskGradientMaterial::~QskGradientMaterial()
+{
+    QskColorRamp::removeReference( m_stops );
+}
+
+void QskGradientMaterial::setStops( const QskGradientStops& stops )
+{
+    // the row of a referenced ramp is not recycled in the atlas
+    QskColorRamp::addReference( stops );
+    QskColorRamp::removeReference( m_stops );
+
+    m_stops = stops;
+}
+
 template< typename Material >
 inline Material* qskEnsureMaterial( QskGradientMaterial* material )
 {
@@ -13,6 +13,8 @@
 class QSK_EXPORT QskGradientMaterial : public QSGMaterial
 {
   public:
+    ~QskGradientMaterial() override;
+
     static QskGradientMaterial* createMaterial( QskGradient::Type );
 
     bool updateGradient( const QRectF&, const QskGradient& );
@@ -39,11 +41,6 @@ inline QskGradient::Type QskGradientMaterial::gradientType() const
     return m_gradientType;
 }
 
-inline void QskGradientMaterial::setStops( const QskGradientStops& stops )
-{
-    m_stops = stops;
-}
-
 inline void QskGradientMaterial::setSpreadMode( QskGradient::SpreadMode spreadMode )
 {
     m_spreadMode = spreadMode;
@@ -6,11 +6,17 @@
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
 #include "QskTextureRenderer.h"
+#include "QskTextureCache.h"
+#include "QskGraphic.h"
+#include "QskSyncQueue.h"
 
 #include <qsgimagenode.h>
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qthreadpool.h>
+
+#include <typeinfo>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -30,6 +36,68 @@ static inline QSGImageNode::TextureCoordinatesTransformMode
     return mode;
 }
 
+static inline QImage qskRasterImage( const QSize& size )
+{
+    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    return image;
+}
+
+class QskPaintedNode::RenderRequest
+{
+  public:
+    QskGraphic graphic;
+
+    QSize size;
+    qreal devicePixelRatio = 1.0;
+
+    QskHashValue hash = 0;
+    QskTextureCache::Key key;
+
+    QQuickWindow* window = nullptr;
+
+    QAtomicInt canceled;
+    QAtomicInt finished;
+
+    // the image has been passed to the node
+    bool isDelivered = false;
+
+    // written by the worker thread before setting finished
+    QImage image;
+
+    void run();
+};
+
+void QskPaintedNode::RenderRequest::run()
+{
+    // running in a worker thread
+
+    if ( canceled.loadAcquire() )
+        return;
+
+    auto rasterImage = qskRasterImage( size );
+
+    {
+        QPainter painter( &rasterImage );
+        painter.scale( devicePixelRatio, devicePixelRatio );
+
+        graphic.render( &painter );
+    }
+
+    image = rasterImage;
+    finished.storeRelease( 1 );
+
+    if ( canceled.loadAcquire() )
+        return;
+
+    /*
+        The result is picked up, when the scene graph gets
+        synchronized. So all we need to do is to request a new frame.
+     */
+    QskSyncQueue::requestUpdate( window );
+}
+
 namespace
 {
     const quint8 imageRole = 250; // reserved for internal use
@@ -49,6 +117,8 @@ QskPaintedNode::QskPaintedNode()
 
 QskPaintedNode::~QskPaintedNode()
 {
+    cancelRendering();
+    releaseTexture();
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -80,6 +150,19 @@ Qt::Orientations QskPaintedNode::mirrored() const
     return m_mirrored;
 }
 
+void QskPaintedNode::setAsynchronous( bool on )
+{
+    m_asynchronous = on;
+
+    if ( !on )
+        cancelRendering();
+}
+
+bool QskPaintedNode::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
 QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
@@ -104,6 +187,9 @@ void QskPaintedNode::update( QQuickWindow* window,
 
     if ( rect.isEmpty() )
     {
+        cancelRendering();
+        releaseTexture();
+
         if ( imageNode )
         {
             removeChildNode( imageNode );
@@ -145,7 +231,6 @@ void QskPaintedNode::update( QQuickWindow* window,
         isTextureDirty = ( imageSize != textureSize() );
     }
 
-
     if ( isTextureDirty )
         updateTexture( window, imageSize, nodeData );
 
@@ -156,41 +241,279 @@ void QskPaintedNode::update( QQuickWindow* window,
 
 void QskPaintedNode::updateTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
+{
+    if ( m_request && ( m_hash != 0 ) )
+    {
+        if ( ( m_request->hash == m_hash )
+            && ( m_request->size == size ) && ( m_request->window == window ) )
+        {
+            // the texture is already on its way
+            return;
+        }
+
+        // superseded
+        cancelRendering();
+    }
+
+    QskTextureCache::Key key;
+
+    if ( m_hash != 0 )
+    {
+        /*
+            Nodes with the same content - f.e. the same icon in all rows
+            of a list - share their texture. As the hash values of different
+            node types might collide, the type is part of the key.
+         */
+        key.hash = qHash( m_hash, qHash( typeid( *this ).hash_code() ) );
+        if ( key.hash == 0 )
+            key.hash = 1; // 0 indicates an invalid key
+        key.size = size;
+        key.devicePixelRatio = window->effectiveDevicePixelRatio();
+
+        if ( key == m_textureKey && window == m_textureWindow )
+            return;
+
+        if ( auto texture = QskTextureCache::acquire( window, key ) )
+        {
+            setSharedTexture( window, key, texture );
+            return;
+        }
+    }
+
+    if ( m_asynchronous && !isOpenGL( window ) )
+    {
+        startRendering( window, size, key, nodeData );
+        return;
+    }
+
+    cancelRendering();
+
+    if ( key.isValid() )
+    {
+        auto texture = createTexture( window, size, nodeData, nullptr );
+        QskTextureCache::insert( window, key, texture );
+
+        setSharedTexture( window, key, texture );
+    }
+    else
+    {
+        auto imageNode = findImageNode( this );
+
+        // a shared texture must not be modified
+        auto reusable = m_textureKey.isValid() ? nullptr : imageNode->texture();
+
+        auto texture = createTexture( window, size, nodeData, reusable );
+        if ( texture != reusable )
+        {
+            imageNode->setTexture( texture );
+            imageNode->setOwnsTexture( true );
+        }
+
+        releaseTexture();
+    }
+}
+
+void QskPaintedNode::setSharedTexture( const QQuickWindow* window,
+    const QskTextureCache::Key& key, QSGTexture* texture )
 {
     auto imageNode = findImageNode( this );
 
-    if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
+    // the previous texture might be deleted - when owned
+    imageNode->setTexture( texture );
+    imageNode->setOwnsTexture( false );
+
+    releaseTexture();
+
+    m_textureKey = key;
+    m_textureWindow = window;
+}
+
+void QskPaintedNode::startRendering( QQuickWindow* window, const QSize& size,
+    const QskTextureCache::Key& key, const void* nodeData )
+{
+    /*
+        nodeData is only valid during the update, so we record the
+        painter commands - what is usually cheap - and leave the expensive
+        part of rasterizing them to a worker thread.
+     */
+
+    const auto ratio = window->effectiveDevicePixelRatio();
+
+    QskGraphic graphic;
+
+    {
+        QPainter painter( &graphic );
+        paint( &painter, size / ratio, nodeData );
+    }
+
+    if ( m_request )
+    {
+        /*
+            Without a hash value we don't know if the content has changed
+            before having recorded the painter commands. But then we
+            can compare the recordings instead.
+         */
+        if ( ( m_request->size == size ) && ( m_request->window == window )
+            && ( m_request->devicePixelRatio == ratio ) && ( m_request->graphic == graphic ) )
+        {
+            return;
+        }
+
+        cancelRendering();
+    }
+
+    m_request.reset( new RenderRequest() );
+    m_request->graphic = graphic;
+    m_request->size = size;
+    m_request->devicePixelRatio = ratio;
+    m_request->hash = m_hash;
+    m_request->key = key;
+    m_request->window = window;
+
+    QskSyncQueue::enqueue( window, this,
+        []( void* node, QQuickWindow* window )
+        { static_cast< QskPaintedNode* >( node )->finishRendering( window ); } );
+
+    QThreadPool::globalInstance()->start(
+        [ request = m_request ] { request->run(); } );
+
+    auto imageNode = findImageNode( this );
+    if ( imageNode->texture() == nullptr )
+    {
+        // a transparent placeholder until the result is available
+
+        auto texture = window->createTextureFromImage( qskRasterImage( QSize( 1, 1 ) ) );
+
+        imageNode->setTexture( texture );
+        imageNode->setOwnsTexture( true );
+    }
+}
+
+void QskPaintedNode::finishRendering( QQuickWindow* window )
+{
+    if ( m_request.isNull() || m_request->isDelivered
+        || m_request->window != window )
+    {
+        return;
+    }
+
+    if ( !m_request->finished.loadAcquire() )
+    {
+        // spurious frame: keep waiting
+        QskSyncQueue::enqueue( window, this,
+            []( void* node, QQuickWindow* window )
+            { static_cast< QskPaintedNode* >( node )->finishRendering( window ); } );
+
+        return;
+    }
+
+    /*
+        The request is kept, so that we can find out if a later
+        update has the same content.
+     */
+    const auto request = m_request;
+    request->isDelivered = true;
+
+    auto imageNode = findImageNode( this );
+    if ( imageNode == nullptr )
+    {
+        m_request.reset();
+        return;
+    }
+
+    const auto& key = request->key;
+
+    if ( key.isValid() )
+    {
+        // another node might have been faster
+        auto texture = QskTextureCache::acquire( window, key );
+        if ( texture == nullptr )
+        {
+            texture = window->createTextureFromImage( request->image );
+            QskTextureCache::insert( window, key, texture );
+        }
+
+        setSharedTexture( window, key, texture );
+    }
+    else
+    {
+        imageNode->setTexture( window->createTextureFromImage( request->image ) );
+        imageNode->setOwnsTexture( true );
+
+        releaseTexture();
+    }
+
+    request->image = QImage();
+}
+
+void QskPaintedNode::cancelRendering()
+{
+    if ( m_request )
+    {
+        if ( !m_request->isDelivered )
+        {
+            m_request->canceled.storeRelease( 1 );
+            QskSyncQueue::dequeue( m_request->window, this );
+        }
+
+        m_request.reset();
+    }
+}
+
+bool QskPaintedNode::isOpenGL( const QQuickWindow* window ) const
+{
+    return ( m_renderHint == OpenGL )
+        && QskTextureRenderer::isOpenGLWindow( window );
+}
+
+void QskPaintedNode::releaseTexture()
+{
+    if ( m_textureKey.isValid() )
+    {
+        QskTextureCache::release( m_textureWindow, m_textureKey );
+
+        m_textureKey = QskTextureCache::Key();
+        m_textureWindow = nullptr;
+    }
+}
+
+QSGTexture* QskPaintedNode::createTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData, QSGTexture* reusable )
+{
+    if ( isOpenGL( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
 
-        auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() );
+        auto texture = qobject_cast< QSGPlainTexture* >( reusable );
         if ( texture == nullptr )
         {
             texture = new QSGPlainTexture;
             texture->setHasAlphaChannel( true );
             texture->setOwnsTexture( true );
-
-            imageNode->setTexture( texture );
         }
 
         QskTextureRenderer::setTextureId( window, textureId, size, texture );
+
+        return texture;
     }
     else
     {
         const auto image = createImage( window, size, nodeData );
 
-        if ( auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() ) )
+        if ( auto texture = qobject_cast< QSGPlainTexture* >( reusable ) )
+        {
             texture->setImage( image );
-        else
-            imageNode->setTexture( window->createTextureFromImage( image ) );
+            return texture;
+        }
+
+        return window->createTextureFromImage( image );
     }
 }
 
 QImage QskPaintedNode::createImage( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
-    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
-    image.fill( Qt::transparent );
+    auto image = qskRasterImage( size );
 
     QPainter painter( &image );
 
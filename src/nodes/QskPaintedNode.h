@@ -7,9 +7,13 @@
 #define QSK_PAINTED_NODE_H
 
 #include "QskGlobal.h"
+#include "QskTextureCache.h"
+
 #include <qsgnode.h>
+#include <qsharedpointer.h>
 
 class QQuickWindow;
+class QSGTexture;
 class QPainter;
 class QImage;
 
@@ -42,6 +46,21 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
+    /*
+        In asynchronous mode the painter commands are recorded and
+        rasterized by a worker thread, keeping the previous texture - or
+        a transparent placeholder - until the result is available.
+
+        This is for the Raster render hint only and works for content,
+        that can be rendered safely outside of the GUI thread
+        ( f.e. no QPixmaps ).
+
+        QskSkinlet enables it for graphics of items with the
+        QskItem::AsynchronousTextures flag ( or QSK_ASYNC_TEXTURES ).
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
     QRectF rect() const;
     QSize textureSize() const;
 
@@ -55,13 +74,36 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
 
   private:
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    void releaseTexture();
+
+    void setSharedTexture( const QQuickWindow*,
+        const QskTextureCache::Key&, QSGTexture* );
+
+    void startRendering( QQuickWindow*, const QSize&,
+        const QskTextureCache::Key&, const void* nodeData );
+    void finishRendering( QQuickWindow* );
+    void cancelRendering();
+
+    bool isOpenGL( const QQuickWindow* ) const;
+
+    QSGTexture* createTexture( QQuickWindow*, const QSize&,
+        const void* nodeData, QSGTexture* reusable );
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
 
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
+    bool m_asynchronous = false;
+
     QskHashValue m_hash = 0;
+
+    // the key of a texture, that is shared with other nodes
+    QskTextureCache::Key m_textureKey;
+    const QQuickWindow* m_textureWindow = nullptr;
+
+    class RenderRequest;
+    QSharedPointer< RenderRequest > m_request;
 };
 
 #endif
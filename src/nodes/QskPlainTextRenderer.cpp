@@ -7,9 +7,13 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 
+#include <qatomic.h>
+#include <qcache.h>
 #include <qfontmetrics.h>
+#include <qglyphrun.h>
 #include <qmath.h>
 #include <qsgnode.h>
+#include <qvector.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -17,6 +21,103 @@ QSK_QT_PRIVATE_END
 
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
+namespace
+{
+    class ShapedTextKey
+    {
+      public:
+        ShapedTextKey( const QString& text, const QFont& font,
+                const QskTextOptions& options, Qt::Alignment alignment, qreal lineWidth )
+            : text( text )
+            , font( font )
+            , options( options )
+            , alignment( alignment )
+            , lineWidth( lineWidth )
+        {
+            hash = qHash( text );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+            hash = qHash( static_cast< int >( alignment ), hash );
+            hash = qHash( lineWidth, hash );
+        }
+
+        inline bool operator==( const ShapedTextKey& other ) const
+        {
+            return ( hash == other.hash ) && ( lineWidth == other.lineWidth )
+                && ( alignment == other.alignment ) && ( options == other.options )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        Qt::Alignment alignment;
+        qreal lineWidth;
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const ShapedTextKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    // the result of laying out a text
+    class ShapedText
+    {
+      public:
+        int glyphCount() const
+        {
+            int count = 0;
+            for ( const auto& glyphRuns : lines )
+            {
+                for ( const auto& glyphRun : glyphRuns )
+                    count += glyphRun.glyphIndexes().count();
+            }
+
+            return count;
+        }
+
+        // the glyph runs of each line
+        QVector< QList< QGlyphRun > > lines;
+
+        qreal textHeight = 0.0;
+        qreal boundingHeight = 0.0;
+    };
+}
+
+static QAtomicInteger< uint > qskShapedTextGeneration;
+
+static QCache< ShapedTextKey, ShapedText >* qskShapedTextCache()
+{
+    /*
+        Shaping is the expensive part of updating a text node, while
+        the same texts are displayed over and over: f.e. the tick labels
+        of an axis or the texts of list rows and buttons.
+
+        The glyph runs refer to font engines, that must not be used from
+        different threads. So the cache is shared between all nodes,
+        that are rendered from the same thread.
+     */
+    static thread_local QCache< ShapedTextKey, ShapedText > cache( 64 * 1024 ); // glyphs
+    static thread_local uint generation = 0;
+
+    const auto currentGeneration = qskShapedTextGeneration.loadRelaxed();
+    if ( generation != currentGeneration )
+    {
+        // QskPlainTextRenderer::clearCache has been called
+        cache.clear();
+        generation = currentGeneration;
+    }
+
+    return &cache;
+}
+
+void QskPlainTextRenderer::clearCache()
+{
+    qskShapedTextGeneration.fetchAndAddRelaxed( 1 );
+}
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
@@ -94,9 +195,43 @@ static qreal qskLayoutText( QTextLayout* layout,
     return y;
 }
 
+static ShapedText qskShapedText( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QTextOption& textOption, qreal lineWidth )
+{
+    const ShapedTextKey key( text, font, options, textOption.alignment(), lineWidth );
+
+    auto cache = qskShapedTextCache();
+
+    if ( const auto cached = cache->object( key ) )
+        return *cached;
+
+    QTextLayout layout;
+    layout.setFont( font );
+    layout.setTextOption( textOption );
+    layout.setText( text );
+
+    layout.beginLayout();
+    const qreal textHeight = qskLayoutText( &layout, lineWidth, options );
+    layout.endLayout();
+
+    ShapedText shapedText;
+    shapedText.textHeight = textHeight;
+    shapedText.boundingHeight = layout.boundingRect().height();
+
+    shapedText.lines.reserve( layout.lineCount() );
+    for ( int i = 0; i < layout.lineCount(); ++i )
+        shapedText.lines += layout.lineAt( i ).glyphRuns();
+
+    cache->insert( key, new ShapedText( shapedText ),
+        qMax( shapedText.glyphCount(), 1 ) );
+
+    return shapedText;
+}
+
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
-    const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
+    QQuickItem* item, QSGNode* parentNode, const QVector< QList< QGlyphRun > >& lines,
+    qreal baseLine, const QColor& color, QQuickText::TextStyle style,
+    const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
     auto sgContext = renderContext->sceneGraphContext();
@@ -118,9 +253,8 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRuns : lines )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
 
         for ( const auto& glyphRun : glyphRuns )
         {
@@ -204,14 +338,8 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     }
 
 
-    QTextLayout layout;
-    layout.setFont( font );
-    layout.setTextOption( textOption );
-    layout.setText( tmp );
-
-    layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
-    layout.endLayout();
+    const ShapedText shapedText = qskShapedText(
+        tmp, font, options, textOption, rect.width() );
 
     const qreal y0 = QFontMetricsF( font ).ascent();
 
@@ -223,7 +351,7 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     }
     else if ( alignment & Qt::AlignBottom )
     {
-        yBaseline += rect.height() - textHeight;
+        yBaseline += rect.height() - shapedText.textHeight;
     }
 
     if ( yBaseline != y0 )
@@ -234,12 +362,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( shapedText.boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, shapedText.lines, yBaseline,
         colors.textColor(), static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor() );
 }
@@ -37,6 +37,12 @@ namespace QskPlainTextRenderer
 
     QSK_EXPORT QRectF textRect( const QString&,
         const QFont&, const QskTextOptions&, const QSizeF& );
+
+    /*
+        Dropping the cached shaped texts. As the caches are per thread
+        they are cleared, when being used the next time.
+     */
+    QSK_EXPORT void clearCache();
 }
 
 #endif
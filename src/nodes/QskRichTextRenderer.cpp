@@ -8,9 +8,12 @@
 #include "QskTextOptions.h"
 
 #include <qglobalstatic.h>
+#include <qhash.h>
 #include <qmutex.h>
 #include <qthread.h>
 
+#include <list>
+
 class QQuickWindow;
 
 QSK_QT_PRIVATE_BEGIN
@@ -20,6 +23,9 @@ QSK_QT_PRIVATE_END
 
 // Since Qt 5.7 QQuickTextNode is public and could be used TODO ...
 
+// maximum number of items for each thread
+static const int qskMaxItemCount = 64;
+
 namespace
 {
     class TextItem final : public QQuickText
@@ -56,6 +62,15 @@ namespace
 
         inline void setGeometry( const QRectF& rect )
         {
+            if ( isComponentComplete() )
+            {
+                // the layout is only updated, when the size has changed
+                setPosition( rect.topLeft() );
+                setSize( rect.size() );
+
+                return;
+            }
+
             auto d = QQuickTextPrivate::get( this );
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 2, 0 )
@@ -107,9 +122,14 @@ namespace
             componentComplete();
         }
 
-        inline void reset()
+        inline void resetPadding()
         {
-            setText( QString() );
+            /*
+                see QskRichTextRenderer::updateNode. Using the setters,
+                so that the text gets relayouted, when a padding has changed
+             */
+            setTopPadding( 0 );
+            setBottomPadding( 0 );
         }
 
         inline QRectF layedOutTextRect() const
@@ -140,6 +160,105 @@ namespace
         }
     };
 
+    class TextItemKey
+    {
+      public:
+        enum Usage
+        {
+            TextSize,
+            TextRect,
+            TextNode
+        };
+
+        TextItemKey( Usage usage, const QString& text,
+                const QFont& font, const QskTextOptions& options )
+            : usage( usage )
+            , text( text )
+            , font( font )
+            , options( options )
+        {
+            hash = qHash( text, usage );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+        }
+
+        inline bool operator==( const TextItemKey& other ) const
+        {
+            return ( hash == other.hash ) && ( usage == other.usage )
+                && ( options == other.options ) && ( text == other.text )
+                && ( font == other.font );
+        }
+
+        Usage usage;
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const TextItemKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    /*
+        Items, that have been initialized with a specific text. As long
+        as the text does not change, QQuickText keeps its internal
+        document and layout between the calls.
+     */
+    class TextItemPool
+    {
+      public:
+        ~TextItemPool()
+        {
+            for ( const auto& entry : std::as_const( m_entries ) )
+                delete entry.item;
+        }
+
+        TextItem* item( const TextItemKey& key, bool& isNew )
+        {
+            auto it = m_entries.find( key );
+            if ( it != m_entries.end() )
+            {
+                // moving the entry to the end of the least recently used list
+                m_usage.splice( m_usage.end(), m_usage, it->usagePos );
+
+                isNew = false;
+                return it->item;
+            }
+
+            if ( m_entries.count() >= qskMaxItemCount )
+            {
+                delete m_entries.take( m_usage.front() ).item;
+                m_usage.pop_front();
+            }
+
+            Entry entry;
+            entry.item = new TextItem();
+            entry.usagePos = m_usage.insert( m_usage.end(), key );
+
+            m_entries.insert( key, entry );
+
+            isNew = true;
+            return entry.item;
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            TextItem* item = nullptr;
+            std::list< TextItemKey >::iterator usagePos;
+        };
+
+        QHash< TextItemKey, Entry > m_entries;
+
+        // the least recently used key first
+        std::list< TextItemKey > m_usage;
+    };
+
     class TextItemMap
     {
       public:
@@ -148,7 +267,13 @@ namespace
             qDeleteAll( m_hash );
         }
 
-        inline TextItem* item()
+        inline TextItem* item( const TextItemKey& key, bool& isNew )
+        {
+            return pool()->item( key, isNew );
+        }
+
+      private:
+        inline TextItemPool* pool()
         {
             const auto thread = QThread::currentThread();
 
@@ -157,27 +282,34 @@ namespace
             auto it = m_hash.constFind( thread );
             if ( it == m_hash.constEnd() )
             {
-                auto textItem = new TextItem();
-                QObject::connect( thread, &QThread::finished,
-                    textItem, [ this, thread ] { removeItem( thread ); } );
-
-                m_hash.insert( thread, textItem );
-                return textItem;
+                auto pool = new TextItemPool();
+
+                /*
+                    The items have to be deleted from the thread they live in,
+                    so we need a direct connection. m_context disconnects,
+                    when the map gets destroyed before the thread has finished.
+                 */
+                QObject::connect( thread, &QThread::finished, &m_context,
+                    [ this, thread ] { removePool( thread ); }, Qt::DirectConnection );
+
+                m_hash.insert( thread, pool );
+                return pool;
             }
 
             return it.value();
         }
 
-      private:
-        void removeItem( const QThread* thread )
+        void removePool( const QThread* thread )
         {
-            auto textItem = m_hash.take( thread );
-            if ( textItem )
-                textItem->deleteLater();
+            QMutexLocker locker( &m_mutex );
+            delete m_hash.take( thread );
         }
 
         QMutex m_mutex;
-        QHash< const QThread*, TextItem* > m_hash;
+        QHash< const QThread*, TextItemPool* > m_hash;
+
+        // destroyed first: no calls of removePool after m_hash is gone
+        QObject m_context;
     };
 }
 
@@ -191,49 +323,58 @@ Q_GLOBAL_STATIC( TextItemMap, qskTextItemMap )
 QSizeF QskRichTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
-    auto& textItem = *qskTextItemMap->item();
-
-    textItem.begin();
+    bool isNew;
 
-    textItem.setFont( font );
-    textItem.setOptions( options );
+    auto& textItem = *qskTextItemMap->item(
+        TextItemKey( TextItemKey::TextSize, text, font, options ), isNew );
 
-    textItem.setWidth( -1 );
-    textItem.setText( text );
+    if ( isNew )
+    {
+        textItem.begin();
 
-    textItem.end();
+        textItem.setFont( font );
+        textItem.setOptions( options );
 
-    const QSizeF sz( textItem.implicitWidth(), textItem.implicitHeight() );
+        textItem.setWidth( -1 );
+        textItem.setText( text );
 
-    textItem.reset();
+        textItem.end();
+    }
 
-    return sz;
+    return QSizeF( textItem.implicitWidth(), textItem.implicitHeight() );
 }
 
 QRectF QskRichTextRenderer::textRect(
     const QString& text, const QFont& font,
     const QskTextOptions& options, const QSizeF& size )
 {
-    auto& textItem = *qskTextItemMap->item();
+    bool isNew;
 
-    textItem.begin();
+    auto& textItem = *qskTextItemMap->item(
+        TextItemKey( TextItemKey::TextRect, text, font, options ), isNew );
 
-    textItem.setFont( font );
-    textItem.setOptions( options );
-    textItem.setAlignment( Qt::Alignment() );
-
-    textItem.setWidth( size.width() );
-    textItem.setHeight( size.height() );
+    if ( isNew )
+    {
+        textItem.begin();
 
-    textItem.setText( text );
+        textItem.setFont( font );
+        textItem.setOptions( options );
+        textItem.setAlignment( Qt::Alignment() );
 
-    textItem.end();
+        textItem.setWidth( size.width() );
+        textItem.setHeight( size.height() );
 
-    const auto rect = textItem.layedOutTextRect();
+        textItem.setText( text );
 
-    textItem.reset();
+        textItem.end();
+    }
+    else
+    {
+        // relayouting only, when the size is different
+        textItem.setSize( size );
+    }
 
-    return rect;
+    return textItem.layedOutTextRect();
 }
 
 void QskRichTextRenderer::updateNode(
@@ -242,19 +383,29 @@ void QskRichTextRenderer::updateNode(
     const QskTextColors& colors, Qt::Alignment alignment,
     const QRectF& rect, const QQuickItem* item, QSGTransformNode* node )
 {
-    // are we killing internal caches of QQuickText, when always using
-    // the same item for the creation the text nodes. TODO ...
+    /*
+        Using an item, that has been initialized with the same text
+        before. Then QQuickText does not need to create a new document
+        and only relayouts, when the geometry or alignment has changed.
+     */
+
+    bool isNew;
 
-    auto& textItem = *qskTextItemMap->item();
+    auto& textItem = *qskTextItemMap->item(
+        TextItemKey( TextItemKey::TextNode, text, font, options ), isNew );
+
+    if ( isNew )
+    {
+        textItem.begin();
 
-    textItem.begin();
+        textItem.setFont( font );
+        textItem.setOptions( options );
+    }
 
+    // the padding of a previous update must not affect the layout
+    textItem.resetPadding();
     textItem.setGeometry( rect );
 
-    textItem.setBottomPadding( 0 );
-    textItem.setTopPadding( 0 );
-    textItem.setFont( font );
-    textItem.setOptions( options );
     textItem.setAlignment( alignment );
 
     textItem.setColor( colors.textColor() );
@@ -262,9 +413,11 @@ void QskRichTextRenderer::updateNode(
     textItem.setStyleColor( colors.styleColor() );
     textItem.setLinkColor( colors.linkColor() );
 
-    textItem.setText( text );
-
-    textItem.end();
+    if ( isNew )
+    {
+        textItem.setText( text );
+        textItem.end();
+    }
 
     if ( alignment & Qt::AlignVCenter )
     {
@@ -289,5 +442,4 @@ void QskRichTextRenderer::updateNode(
     }
 
     textItem.updateTextNode( item->window(), node );
-    textItem.reset();
 }
@@ -4,9 +4,31 @@
  *****************************************************************************/
 
 #include "QskSGNode.h"
+#include "QskTreeNode.h"
+
+static inline void qskSetIndexed( QSGNode* parent, QSGNode* child, bool on )
+{
+    /*
+        Only the paint nodes of the controls ( QskTreeNode ) have a
+        table for looking up their children by role. Those are
+        the parents, where the skinlets are inserting their nodes.
+     */
+    if ( auto treeNode = qskTreeNodeCast( parent ) )
+    {
+        const auto role = QskSGNode::nodeRole( child );
+        if ( role == QskSGNode::NoRole )
+            return;
+
+        if ( on )
+            treeNode->setRoleNode( role, child );
+        else if ( treeNode->roleNode( role ) == child )
+            treeNode->setRoleNode( role, nullptr );
+    }
+}
 
 static inline void qskRemoveChildNode( QSGNode* parent, QSGNode* child )
 {
+    qskSetIndexed( parent, child, false );
     parent->removeChildNode( child );
 
     if ( child->flags() & QSGNode::OwnedByParent )
@@ -25,41 +47,55 @@ static inline void qskRemoveAllChildNodesAfter( QSGNode* parent, QSGNode* child
     }
 }
 
+static inline QSGNode* qskPrecedingNode( const QskTreeNode* parent,
+    const QVector< quint8 >& roles, int nodePos )
+{
+    for ( int i = nodePos - 1; i >= 0; i-- )
+    {
+        if ( auto node = parent->roleNode( roles[ i ] ) )
+            return node;
+    }
+
+    return parent->roleNode( QskSGNode::BackgroundRole );
+}
+
 static void qskInsertChildSorted( QSGNode* parent, QSGNode* child,
     const QVector< quint8 >& roles )
 {
     QSGNode* sibling = nullptr;
 
-    if ( parent->childCount() > 0 )
+    if ( parent->firstChild() )
     {
         using namespace QskSGNode;
 
         const int nodePos = roles.indexOf( nodeRole( child ) );
 
-        // in most cases we are appending, so let's start at the end
-
-        for ( auto childNode = parent->lastChild();
-            childNode != nullptr; childNode = childNode->previousSibling() )
+        if ( const auto treeNode = qskTreeNodeCast( parent ) )
         {
-            const auto childNodeRole = nodeRole( childNode );
-            if ( childNodeRole == BackgroundRole )
-            {
-                sibling = childNode;
-            }
-            else
-            {
-                /*
-                   Imperformant implementation, but as the number of roles is
-                   usually < 5 we don't introduce some sort of support for faster lookups
-                 */
+            sibling = qskPrecedingNode( treeNode, roles, nodePos );
+        }
+        else
+        {
+            // in most cases we are appending, so let's start at the end
 
-                const int index = roles.indexOf( nodeRole( childNode ) );
-                if ( index >= 0 && index < nodePos )
+            for ( auto childNode = parent->lastChild();
+                childNode != nullptr; childNode = childNode->previousSibling() )
+            {
+                const auto childNodeRole = nodeRole( childNode );
+                if ( childNodeRole == BackgroundRole )
+                {
                     sibling = childNode;
+                }
+                else
+                {
+                    const int index = roles.indexOf( childNodeRole );
+                    if ( index >= 0 && index < nodePos )
+                        sibling = childNode;
+                }
+
+                if ( sibling != nullptr )
+                    break;
             }
-
-            if ( sibling != nullptr )
-                break;
         }
     }
 
@@ -78,10 +114,16 @@ void QskSGNode::setParentNode( QSGNode* node, QSGNode* parent )
         if ( oldParent != parent )
         {
             if ( oldParent )
+            {
+                qskSetIndexed( oldParent, node, false );
                 oldParent->removeChildNode( node );
+            }
 
             if ( parent )
+            {
                 parent->appendChildNode( node );
+                qskSetIndexed( parent, node, true );
+            }
         }
     }
 }
@@ -90,6 +132,17 @@ QSGNode* QskSGNode::findChildNode( QSGNode* parent, quint8 role )
 {
     if ( parent )
     {
+        if ( role != NoRole )
+        {
+            if ( const auto treeNode = qskTreeNodeCast( parent ) )
+            {
+                auto node = treeNode->roleNode( role );
+                Q_ASSERT( node == nullptr || node->parent() == parent );
+
+                return node;
+            }
+        }
+
         auto node = parent->firstChild();
         while ( node )
         {
@@ -162,12 +215,11 @@ void QskSGNode::replaceChildNode(
         }
     }
 
+    if ( newNode )
+        qskSetIndexed( parentNode, newNode, true );
+
     if ( oldNode && oldNode != newNode )
-    {
-        parentNode->removeChildNode( oldNode );
-        if ( oldNode->flags() & QSGNode::OwnedByParent )
-            delete oldNode;
-    }
+        qskRemoveChildNode( parentNode, oldNode );
 }
 
 void QskSGNode::resetGeometry( QSGGeometryNode* node )
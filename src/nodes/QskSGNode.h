@@ -71,7 +71,7 @@ namespace QskSGNode
     inline Node* appendChildNode( QSGNode* parent, quint8 role )
     {
         auto node = createNode< Node >( role );
-        parent->appendChildNode( node );
+        setParentNode( node, parent );
 
         return node;
     }
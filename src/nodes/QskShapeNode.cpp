@@ -8,92 +8,314 @@
 #include "QskGradientDirection.h"
 #include "QskVertex.h"
 #include "QskFillNodePrivate.h"
+#include "QskSyncQueue.h"
+
+#include <qcache.h>
+#include <qglobalstatic.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsharedpointer.h>
+#include <qthreadpool.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qvectorpath_p.h>
 #include <private/qtriangulator_p.h>
 QSK_QT_PRIVATE_END
 
-#if 0
+/*
+    Paths with more elements are triangulated in a worker thread,
+    when a window has been passed to QskShapeNode::updatePath
+ */
+static const int qskAsyncElementCount = 500;
 
-// keeping the index list
-static void qskUpdateGeometry( const QPainterPath& path,
-    const QTransform& transform, const QColor&, QSGGeometry& geometry )
+namespace
 {
-    const auto ts = qTriangulate( path, transform, 1, false );
-
-    geometry.allocate( ts.vertices.size(), ts.indices.size() );
+    /*
+        QTriangleSet with floats instead of qreals - ready
+        to be copied into the geometry.
+     */
+    class Triangles
+    {
+      public:
+        Triangles() = default;
 
-    auto vertexData = reinterpret_cast< float* >( geometry.vertexData() );
-    const auto points = ts.vertices.constData();
+        Triangles( const QPainterPath& path, const QTransform& transform )
+        {
+            const auto ts = qTriangulate( path, transform, 1, false );
 
-    for ( int i = 0; i < ts.vertices.count(); i++ )
-        vertexData[i] = points[i];
+            vertices.reserve( ts.vertices.size() );
+            for ( const auto value : ts.vertices )
+                vertices += value;
 
-    memcpy( geometry.indexData(), ts.indices.data(),
-        ts.indices.size() * sizeof( quint16 ) );
-}
+            const auto data = reinterpret_cast< const quint16* >( ts.indices.data() );
+            indices = QVector< quint16 >( data, data + ts.indices.size() );
+        }
 
-#else
+        inline int bytes() const
+        {
+            return vertices.size() * sizeof( float )
+                + indices.size() * sizeof( quint16 );
+        }
 
-static void qskUpdateGeometry( const QPainterPath& path,
-    const QTransform& transform, const QColor& color, QSGGeometry& geometry )
-{
-    const auto ts = qTriangulate( path, transform, 1, false );
+        QVector< float > vertices; // [x[0], y[0], x[1], y[1], x[2], ...]
+        QVector< quint16 > indices;
+    };
 
     /*
-        The triangulation of a random path usually does not lead to index lists
-        that allow substantially reducing the number of vertices.
+        As translating the vertices is way cheaper than the triangulation,
+        the transformation is split into translation and the rest.
+     */
+    class TriangulationKey
+    {
+      public:
+        TriangulationKey( const QPainterPath& path, const QTransform& transform )
+            : path( path )
+        {
+            if ( transform.type() <= QTransform::TxShear )
+            {
+                linearTransform = QTransform( transform.m11(), transform.m12(),
+                    transform.m21(), transform.m22(), 0.0, 0.0 );
+
+                dx = transform.dx();
+                dy = transform.dy();
+            }
+            else
+            {
+                linearTransform = transform;
+            }
+
+            hash = qHash( int( path.fillRule() ), 15000 );
+
+            for ( int i = 0; i < path.elementCount(); i++ )
+            {
+                const auto element = path.elementAt( i );
+
+                hash = qHash( element.x, hash );
+                hash = qHash( element.y, hash );
+                hash = qHash( int( element.type ), hash );
+            }
+
+            const qreal m[] = { linearTransform.m11(), linearTransform.m12(),
+                linearTransform.m21(), linearTransform.m22(),
+                linearTransform.m31(), linearTransform.m32() };
+
+            hash = qHashBits( m, sizeof( m ), hash );
+        }
+
+        inline bool operator==( const TriangulationKey& other ) const
+        {
+            return ( hash == other.hash )
+                && ( linearTransform == other.linearTransform )
+                && ( path == other.path );
+        }
 
-        As we have to iterate over the vertex buffer to copy qreal to float
-        anyway we reorder according to the index buffer and drop
-        the index buffer.
+        QPainterPath path;
+        QTransform linearTransform;
+        QskHashValue hash = 0;
 
-        QTriangleSet:
+        // not part of the key
+        qreal dx = 0.0;
+        qreal dy = 0.0;
+    };
 
-        vertices: (x[i[n]], y[i[n]]), (x[j[n]], y[j[n]]), (x[k[n]], y[k[n]]), n = 0, 1, ...
-        QVector<qreal> vertices; // [x[0], y[0], x[1], y[1], x[2], ...]
-        QVector<quint16> indices; // [i[0], j[0], k[0], i[1], j[1], k[1], i[2], ...]
+    inline QskHashValue qHash( const TriangulationKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    class TriangulationCache
+    {
+      public:
+        TriangulationCache()
+            : m_cache( 4 * 1024 * 1024 ) // bytes
+        {
+        }
+
+        bool find( const TriangulationKey& key, Triangles& triangles )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( auto cached = m_cache.object( key ) )
+            {
+                triangles = *cached;
+                return true;
+            }
+
+            return false;
+        }
+
+        void insert( const TriangulationKey& key, const Triangles& triangles )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new Triangles( triangles ), triangles.bytes() );
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< TriangulationKey, Triangles > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( TriangulationCache, qskTriangulationCache )
+
+static void qskUpdateGeometry( const Triangles& triangles,
+    qreal dx, qreal dy, const QColor& color, QSGGeometry& geometry )
+{
+    /*
+        The vertices are shared between the triangles, so we keep
+        the index list instead of expanding the vertices.
      */
 
-    const auto points = ts.vertices.constData();
-    const auto indices = reinterpret_cast< const quint16* >( ts.indices.data() );
+    const int vertexCount = triangles.vertices.size() / 2;
+    const auto points = triangles.vertices.constData();
 
-    geometry.allocate( ts.indices.size() );
+    geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+    geometry.allocate( vertexCount, triangles.indices.size() );
 
     if ( color.isValid() )
     {
         const QskVertex::Color c = color;
 
         auto vertexData = geometry.vertexDataAsColoredPoint2D();
-        for ( int i = 0; i < ts.indices.size(); i++ )
+        for ( int i = 0; i < vertexCount; i++ )
         {
-            const int j = 2 * indices[i];
-            vertexData[i].set( points[j], points[j + 1], c.r, c.g, c.b, c.a );
+            vertexData[i].set( points[2 * i] + dx, points[2 * i + 1] + dy,
+                c.r, c.g, c.b, c.a );
         }
     }
     else
     {
         auto vertexData = geometry.vertexDataAsPoint2D();
-        for ( int i = 0; i < ts.indices.size(); i++ )
+        for ( int i = 0; i < vertexCount; i++ )
+            vertexData[i].set( points[2 * i] + dx, points[2 * i + 1] + dy );
+    }
+
+    memcpy( geometry.indexDataAsUShort(), triangles.indices.constData(),
+        triangles.indices.size() * sizeof( quint16 ) );
+}
+
+static Triangles qskTriangles( const QSGGeometry& geometry )
+{
+    // the triangles of a geometry, that has been set up by qskUpdateGeometry
+
+    Triangles triangles;
+
+    const int vertexCount = geometry.vertexCount();
+
+    triangles.vertices.resize( 2 * vertexCount );
+    auto points = triangles.vertices.data();
+
+    if ( geometry.attributeCount() != 1 )
+    {
+        const auto vertexData = geometry.vertexDataAsColoredPoint2D();
+        for ( int i = 0; i < vertexCount; i++ )
         {
-            const int j = 2 * indices[i];
-            vertexData[i].set( points[j], points[j + 1] );
+            points[2 * i] = vertexData[i].x;
+            points[2 * i + 1] = vertexData[i].y;
         }
     }
+    else
+    {
+        const auto vertexData = geometry.vertexDataAsPoint2D();
+        for ( int i = 0; i < vertexCount; i++ )
+        {
+            points[2 * i] = vertexData[i].x;
+            points[2 * i + 1] = vertexData[i].y;
+        }
+    }
+
+    const auto indices = geometry.indexDataAsUShort();
+    triangles.indices = QVector< quint16 >( indices, indices + geometry.indexCount() );
+
+    return triangles;
 }
 
-#endif
+static QPainterPath qskDetachedPath( const QPainterPath& path )
+{
+    /*
+        qTriangulate creates a QVectorPath, that is cached inside of the
+        private data of the path. As the private data might be shared
+        with paths, that are in use in other threads, the job needs a
+        copy of its own.
+     */
+    QPainterPath detachedPath( path );
+
+    if ( detachedPath.elementCount() > 0 )
+    {
+        // setElementPositionAt detaches the private data
+        const auto element = detachedPath.elementAt( 0 );
+        detachedPath.setElementPositionAt( 0, element.x, element.y );
+    }
+
+    return detachedPath;
+}
+
+namespace
+{
+    class TriangulationJob
+    {
+      public:
+        TriangulationJob( const TriangulationKey& key, QQuickWindow* window )
+            : key( key )
+            , path( qskDetachedPath( key.path ) )
+            , window( window )
+        {
+        }
+
+        void run()
+        {
+            // running in a worker thread
+
+            if ( canceled.loadAcquire() )
+                return;
+
+            triangles = Triangles( path, key.linearTransform );
+            finished.storeRelease( 1 );
+
+            if ( !canceled.loadAcquire() )
+                QskSyncQueue::requestUpdate( window );
+        }
+
+        const TriangulationKey key;
+
+        // not shared with any other path
+        const QPainterPath path;
+
+        QQuickWindow* window;
+
+        QAtomicInt canceled;
+        QAtomicInt finished;
+
+        // written by the worker thread before setting finished
+        Triangles triangles;
+    };
+}
 
 class QskShapeNodePrivate final : public QskFillNodePrivate
 {
   public:
+    void cancelJob( QskShapeNode* node )
+    {
+        if ( job )
+        {
+            job->canceled.storeRelease( 1 );
+            QskSyncQueue::dequeue( job->window, node );
+
+            job.reset();
+        }
+    }
+
     /*
         Is there a better way to find out if the path has changed
         beside storing a copy ( even, when internally with Copy On Write ) ?
      */
     QPainterPath path;
     QTransform transform;
+
+    // the color of the vertices, when having a colored geometry
+    QColor color;
+
+    QSharedPointer< TriangulationJob > job;
 };
 
 QskShapeNode::QskShapeNode()
@@ -113,15 +335,25 @@ QskShapeNode::QskShapeNode()
 
 QskShapeNode::~QskShapeNode()
 {
+    Q_D( QskShapeNode );
+    d->cancelJob( this );
 }
 
 void QskShapeNode::updatePath( const QPainterPath& path,
     const QTransform& transform, const QRectF& rect, const QskGradient& gradient )
+{
+    updatePath( nullptr, path, transform, rect, gradient );
+}
+
+void QskShapeNode::updatePath( QQuickWindow* window, const QPainterPath& path,
+    const QTransform& transform, const QRectF& rect, const QskGradient& gradient )
 {
     Q_D( QskShapeNode );
 
     if ( path.isEmpty() || !gradient.isVisible() )
     {
+        d->cancelJob( this );
+
         d->path = QPainterPath();
         d->transform = QTransform();
         resetGeometry();
@@ -134,21 +366,115 @@ void QskShapeNode::updatePath( const QPainterPath& path,
     if ( gradient.isMonochrome() && hasHint( PreferColoredGeometry ) )
         c = gradient.startColor();
 
-    const bool isDirty = ( isGeometryColored() != c.isValid() );
+    const bool isColorDirty =
+        ( isGeometryColored() != c.isValid() ) || ( c != d->color );
+
+    /*
+        Changing the coloring might replace the geometry by one with
+        a different vertex layout. Then we convert the current
+        vertices, so that the previous geometry is kept, while a
+        triangulation is running.
+     */
+    Triangles triangles;
+
+    if ( isColorDirty )
+        triangles = qskTriangles( *geometry() );
 
     if ( c.isValid() )
         setColoring( QskFillNode::Polychrome );
     else
         setColoring( rect, gradient );
 
-    if ( isDirty || ( transform != d->transform ) || ( path != d->path ) )
+    if ( isColorDirty )
+    {
+        d->color = c;
+
+        qskUpdateGeometry( triangles, 0.0, 0.0, c, *geometry() );
+
+        geometry()->markVertexDataDirty();
+        geometry()->markIndexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+
+    if ( ( transform != d->transform ) || ( path != d->path ) )
     {
         d->path = path;
         d->transform = transform;
 
-        qskUpdateGeometry( path, transform, c, *geometry() );
+        const TriangulationKey key( path, transform );
+
+        if ( d->job && d->job->key == key )
+        {
+            // still waiting for the same triangulation
+            return;
+        }
+
+        d->cancelJob( this );
+
+        if ( !qskTriangulationCache->find( key, triangles ) )
+        {
+            if ( window && ( path.elementCount() >= qskAsyncElementCount ) )
+            {
+                /*
+                    Keeping the previous geometry until the
+                    result from the worker thread is available
+                 */
+                d->job.reset( new TriangulationJob( key, window ) );
+
+                QskSyncQueue::enqueue( window, this,
+                    []( void* node, QQuickWindow* window )
+                    { static_cast< QskShapeNode* >( node )->finishTriangulation( window ); } );
+
+                QThreadPool::globalInstance()->start(
+                    [ job = d->job ] { job->run(); } );
+
+                return;
+            }
+
+            triangles = Triangles( key.path, key.linearTransform );
+            qskTriangulationCache->insert( key, triangles );
+        }
+
+        qskUpdateGeometry( triangles, key.dx, key.dy, c, *geometry() );
 
         geometry()->markVertexDataDirty();
+        geometry()->markIndexDataDirty();
         markDirty( QSGNode::DirtyGeometry );
     }
 }
+
+void QskShapeNode::finishTriangulation( QQuickWindow* window )
+{
+    Q_D( QskShapeNode );
+
+    const auto job = d->job;
+
+    if ( job.isNull() || job->window != window )
+        return;
+
+    if ( !job->finished.loadAcquire() )
+    {
+        // spurious frame: keep waiting
+        QskSyncQueue::enqueue( window, this,
+            []( void* node, QQuickWindow* window )
+            { static_cast< QskShapeNode* >( node )->finishTriangulation( window ); } );
+
+        return;
+    }
+
+    d->job.reset();
+
+    qskTriangulationCache->insert( job->key, job->triangles );
+
+    /*
+        The transformation might have changed meanwhile,
+        but only by its translation.
+     */
+    const TriangulationKey key( d->path, d->transform );
+
+    qskUpdateGeometry( job->triangles, key.dx, key.dy, d->color, *geometry() );
+
+    geometry()->markVertexDataDirty();
+    geometry()->markIndexDataDirty();
+    markDirty( QSGNode::DirtyGeometry );
+}
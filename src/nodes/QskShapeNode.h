@@ -12,6 +12,7 @@
 class QskGradient;
 class QColor;
 class QPainterPath;
+class QQuickWindow;
 
 class QskShapeNodePrivate;
 
@@ -26,7 +27,20 @@ class QSK_EXPORT QskShapeNode : public QskFillNode
     void updatePath( const QPainterPath&, const QTransform&,
         const QRectF&, const QskGradient& );
 
+    /*
+        With a window paths with many elements are triangulated in a
+        worker thread. The previous geometry is displayed until the
+        result is available.
+
+        The controls of the library do not fill paths with QskShapeNode,
+        so this is for application code only - see playground/shapes.
+     */
+    void updatePath( QQuickWindow*, const QPainterPath&, const QTransform&,
+        const QRectF&, const QskGradient& );
+
   private:
+    void finishTriangulation( QQuickWindow* );
+
     Q_DECLARE_PRIVATE( QskShapeNode )
 };
 
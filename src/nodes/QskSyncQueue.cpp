@@ -0,0 +1,162 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSyncQueue.h"
+
+#include <qcoreapplication.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+
+namespace
+{
+    class Queue : public QObject
+    {
+      public:
+        using Callbacks = QHash< void*, QskSyncQueue::Callback >;
+
+        void enqueue( QQuickWindow* window,
+            void* object, QskSyncQueue::Callback callback )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_windows.find( window );
+            if ( it == m_windows.end() )
+            {
+                /*
+                    The queue is the context of the connections, so that they
+                    are removed, when it gets destroyed before the window.
+                    As the queue might have been created in the scene graph
+                    thread, the connections have to be direct.
+                 */
+                connect( window, &QQuickWindow::beforeSynchronizing,
+                    this, [ this, window ] { process( window ); },
+                    Qt::DirectConnection );
+
+                connect( window, &QObject::destroyed,
+                    this, [ this, window ] { removeWindow( window ); },
+                    Qt::DirectConnection );
+
+                it = m_windows.insert( window, Window { ++m_lastId, {} } );
+            }
+
+            it->callbacks.insert( object, callback );
+        }
+
+        void dequeue( QQuickWindow* window, void* object )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            auto it = m_windows.find( window );
+            if ( it != m_windows.end() )
+                it->callbacks.remove( object );
+        }
+
+        void requestUpdate( QQuickWindow* window )
+        {
+            // called from a worker thread, the window might be gone
+
+            quint64 id = 0;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                auto it = m_windows.constFind( window );
+                if ( it == m_windows.constEnd() )
+                    return;
+
+                id = it->id;
+            }
+
+            /*
+                Only the address and the id are passed to the GUI thread,
+                where the window gets destroyed. An address, that has been
+                reused for another window, comes with a different id.
+
+                The queue might live in the scene graph thread, so
+                we post to the application object.
+             */
+            if ( auto app = QCoreApplication::instance() )
+            {
+                QMetaObject::invokeMethod( app,
+                    [ this, window, id ] { updateWindow( window, id ); },
+                    Qt::QueuedConnection );
+            }
+        }
+
+      private:
+        class Window
+        {
+          public:
+            quint64 id;
+            Callbacks callbacks;
+        };
+
+        void process( QQuickWindow* window )
+        {
+            Callbacks callbacks;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                auto it = m_windows.find( window );
+                if ( it != m_windows.end() )
+                    callbacks.swap( it->callbacks );
+            }
+
+            for ( auto it = callbacks.constBegin(); it != callbacks.constEnd(); ++it )
+                it.value()( it.key(), window );
+        }
+
+        void updateWindow( QQuickWindow* window, quint64 id )
+        {
+            // running in the GUI thread
+
+            bool isAlive = false;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                auto it = m_windows.constFind( window );
+                isAlive = ( it != m_windows.constEnd() ) && ( it->id == id );
+            }
+
+            if ( isAlive )
+                window->update();
+        }
+
+        void removeWindow( QQuickWindow* window )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_windows.remove( window );
+        }
+
+        QMutex m_mutex;
+        QHash< QQuickWindow*, Window > m_windows;
+
+        quint64 m_lastId = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( Queue, qskQueue )
+
+void QskSyncQueue::enqueue( QQuickWindow* window, void* object, Callback callback )
+{
+    if ( window && object && callback )
+        qskQueue->enqueue( window, object, callback );
+}
+
+void QskSyncQueue::dequeue( QQuickWindow* window, void* object )
+{
+    if ( window && object )
+        qskQueue->dequeue( window, object );
+}
+
+void QskSyncQueue::requestUpdate( QQuickWindow* window )
+{
+    if ( window )
+        qskQueue->requestUpdate( window );
+}
@@ -0,0 +1,37 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SYNC_QUEUE_H
+#define QSK_SYNC_QUEUE_H
+
+#include "QskGlobal.h"
+
+class QQuickWindow;
+
+/*
+    Callbacks, that are processed when the scene graph of a window gets
+    synchronized ( QQuickWindow::beforeSynchronizing ). As the GUI thread is
+    blocked at this point nodes can be modified from there.
+
+    Used by nodes to pick up the results of jobs, that have been running
+    in worker threads.
+ */
+namespace QskSyncQueue
+{
+    using Callback = void (*)( void* object, QQuickWindow* );
+
+    // the callback is called once - enqueue again, when needed
+    void enqueue( QQuickWindow*, void* object, Callback );
+    void dequeue( QQuickWindow*, void* object );
+
+    /*
+        Can be called from any thread. The window is not dereferenced
+        before it has been verified in the GUI thread, that it is still
+        alive. So it might have been deleted in the meantime.
+     */
+    void requestUpdate( QQuickWindow* );
+}
+
+#endif
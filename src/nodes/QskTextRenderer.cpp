@@ -8,7 +8,146 @@
 #include "QskRichTextRenderer.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
+#include <qfont.h>
+#include <qglobalstatic.h>
+#include <qguiapplication.h>
+#include <qmutex.h>
 #include <qrect.h>
+#include <qscreen.h>
+
+namespace
+{
+    class MeasurementKey
+    {
+      public:
+        MeasurementKey( const QString& text, const QFont& font,
+                const QskTextOptions& options, const QSizeF& size = QSizeF() )
+            : text( text )
+            , font( font )
+            , options( options )
+            , size( size )
+        {
+            hash = qHash( text );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+            hash = qHash( size.width(), hash );
+            hash = qHash( size.height(), hash );
+        }
+
+        inline bool operator==( const MeasurementKey& other ) const
+        {
+            return ( hash == other.hash ) && ( size == other.size )
+                && ( options == other.options ) && ( text == other.text )
+                && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        QSizeF size;
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const MeasurementKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    class MeasurementCache
+    {
+      public:
+        MeasurementCache()
+            : m_sizes( 1000 )
+        {
+        }
+
+        bool find( const MeasurementKey& key, QSizeF& size )
+        {
+            if ( const auto cachedSize = m_sizes.object( key ) )
+            {
+                counters.hits++;
+                size = *cachedSize;
+
+                return true;
+            }
+
+            counters.misses++;
+            return false;
+        }
+
+        void insert( const MeasurementKey& key, const QSizeF& size )
+        {
+            m_sizes.insert( key, new QSizeF( size ) );
+            counters.entryCount = m_sizes.count();
+        }
+
+        void setMaxCost( int cost )
+        {
+            m_sizes.setMaxCost( cost );
+            counters.entryCount = m_sizes.count();
+        }
+
+        int maxCost() const
+        {
+            return m_sizes.maxCost();
+        }
+
+        void clear()
+        {
+            m_sizes.clear();
+            counters.entryCount = 0;
+        }
+
+        QskTextRenderer::Statistics::Counters counters;
+
+      private:
+        QCache< MeasurementKey, QSizeF > m_sizes;
+    };
+
+    class Measurements
+    {
+      public:
+        QMutex mutex;
+
+        MeasurementCache unconstrained;
+        MeasurementCache constrained;
+    };
+}
+
+Q_GLOBAL_STATIC( Measurements, qskMeasurements )
+
+static void qskTextRendererHook()
+{
+    /*
+        Font families might resolve differently, when the font database
+        changes. Sizes of fonts in points depend on the logical DPI.
+     */
+
+    if ( auto app = qobject_cast< QGuiApplication* >( QCoreApplication::instance() ) )
+    {
+        QObject::connect( app, &QGuiApplication::fontDatabaseChanged,
+            app, &QskTextRenderer::clearCache );
+
+        QObject::connect( app, &QGuiApplication::primaryScreenChanged,
+            app, &QskTextRenderer::clearCache );
+
+        const auto connectScreen = [ app ]( const QScreen* screen )
+        {
+            QObject::connect( screen, &QScreen::logicalDotsPerInchChanged,
+                app, &QskTextRenderer::clearCache );
+        };
+
+        const auto screens = QGuiApplication::screens();
+        for ( const auto screen : screens )
+            connectScreen( screen );
+
+        QObject::connect( app, &QGuiApplication::screenAdded, app, connectScreen );
+    }
+}
+
+Q_COREAPP_STARTUP_FUNCTION( qskTextRendererHook )
 
 /*
     Since Qt 5.7 QQuickTextNode is exported as Q_QUICK_PRIVATE_EXPORT
@@ -17,20 +156,101 @@
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
+    const MeasurementKey key( text, font, options );
+
+    auto measurements = qskMeasurements;
+
+    QSizeF textSize;
+
+    {
+        QMutexLocker locker( &measurements->mutex );
+        if ( measurements->unconstrained.find( key, textSize ) )
+            return textSize;
+    }
+
+    // measuring without holding the lock
+
     if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-        return QskPlainTextRenderer::textSize( text, font, options );
+        textSize = QskPlainTextRenderer::textSize( text, font, options );
     else
-        return QskRichTextRenderer::textSize( text, font, options );
+        textSize = QskRichTextRenderer::textSize( text, font, options );
+
+    QMutexLocker locker( &measurements->mutex );
+    measurements->unconstrained.insert( key, textSize );
+
+    return textSize;
 }
 
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
+    const MeasurementKey key( text, font, options, size );
+
+    auto measurements = qskMeasurements;
+
+    QSizeF textSize;
+
+    {
+        QMutexLocker locker( &measurements->mutex );
+        if ( measurements->constrained.find( key, textSize ) )
+            return textSize;
+    }
+
     if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-        return QskPlainTextRenderer::textRect( text, font, options, size ).size();
+        textSize = QskPlainTextRenderer::textRect( text, font, options, size ).size();
     else
-        return QskRichTextRenderer::textRect( text, font, options, size ).size();
+        textSize = QskRichTextRenderer::textRect( text, font, options, size ).size();
+
+    QMutexLocker locker( &measurements->mutex );
+    measurements->constrained.insert( key, textSize );
+
+    return textSize;
+}
+
+QskTextRenderer::Statistics QskTextRenderer::statistics()
+{
+    auto measurements = qskMeasurements;
+
+    QMutexLocker locker( &measurements->mutex );
+
+    Statistics statistics;
+    statistics.unconstrained = measurements->unconstrained.counters;
+    statistics.constrained = measurements->constrained.counters;
+
+    return statistics;
+}
+
+void QskTextRenderer::setMaximumCacheSize( int entries )
+{
+    auto measurements = qskMeasurements;
+
+    QMutexLocker locker( &measurements->mutex );
+
+    entries = qMax( entries, 0 );
+
+    measurements->unconstrained.setMaxCost( entries );
+    measurements->constrained.setMaxCost( entries );
+}
+
+int QskTextRenderer::maximumCacheSize()
+{
+    auto measurements = qskMeasurements;
+
+    QMutexLocker locker( &measurements->mutex );
+    return measurements->unconstrained.maxCost();
+}
+
+void QskTextRenderer::clearCache()
+{
+    auto measurements = qskMeasurements;
+
+    QMutexLocker locker( &measurements->mutex );
+
+    measurements->unconstrained.clear();
+    measurements->constrained.clear();
+
+    QskPlainTextRenderer::clearCache();
 }
 
 void QskTextRenderer::updateNode(
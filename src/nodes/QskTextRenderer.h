@@ -31,6 +31,42 @@ namespace QskTextRenderer
 
     QSK_EXPORT QSizeF textSize(
         const QString&, const QFont&, const QskTextOptions&, const QSizeF& );
+
+    /*
+        The results of textSize are cached, as size hints are calculated
+        over and over for the same texts. There are separate caches for
+        the unconstrained and the constrained queries, each of them
+        dropping the least recently used entries first.
+     */
+
+    class Statistics
+    {
+      public:
+        class Counters
+        {
+          public:
+            quint64 hits = 0;
+            quint64 misses = 0;
+
+            int entryCount = 0;
+        };
+
+        Counters unconstrained;
+        Counters constrained;
+    };
+
+    QSK_EXPORT Statistics statistics();
+
+    // default: 1000 entries for each cache
+    QSK_EXPORT void setMaximumCacheSize( int entries );
+    QSK_EXPORT int maximumCacheSize();
+
+    /*
+        Clears the measurements and the shaped texts of QskPlainTextRenderer.
+        This happens automatically, when QGuiApplication::fontDatabaseChanged
+        is emitted - f.e after application fonts have been added.
+     */
+    QSK_EXPORT void clearCache();
 }
 
 #endif
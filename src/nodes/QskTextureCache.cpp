@@ -0,0 +1,231 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+
+#include <qatomic.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+#include <list>
+
+static QAtomicInteger< qint64 > qskMaximumBytes( 32 * 1024 * 1024 );
+
+static inline qint64 qskTextureBytes( const QSize& size )
+{
+    // all our textures are RGBA8
+    return qint64( size.width() ) * size.height() * 4;
+}
+
+namespace
+{
+    class Cache
+    {
+      public:
+        class Entry
+        {
+          public:
+            QSGTexture* texture = nullptr;
+            qint64 bytes = 0;
+
+            int refCount = 0;
+
+            // position in the list of unused textures
+            std::list< QskTextureCache::Key >::iterator unusedPos;
+        };
+
+        ~Cache()
+        {
+            for ( const auto& entry : std::as_const( entries ) )
+                delete entry.texture;
+        }
+
+        void trim( qint64 maxBytes )
+        {
+            while ( ( statistics.bytes > maxBytes ) && !unused.empty() )
+            {
+                auto it = entries.find( unused.front() );
+                unused.pop_front();
+
+                statistics.bytes -= it->bytes;
+                statistics.textureCount--;
+                statistics.unusedTextureCount--;
+                statistics.evictions++;
+
+                delete it->texture;
+                entries.erase( it );
+            }
+        }
+
+        QHash< QskTextureCache::Key, Entry > entries;
+
+        // unused textures, the least recently used first
+        std::list< QskTextureCache::Key > unused;
+
+        QskTextureCache::Statistics statistics;
+
+        QMetaObject::Connection connection;
+    };
+
+    class Registry
+    {
+      public:
+        /*
+            No destructor deleting the caches: without a scene graph
+            the textures can't be deleted safely.
+         */
+
+        Cache* cache( const QQuickWindow* window ) const
+        {
+            return caches.value( window, nullptr );
+        }
+
+        Cache* ensureCache( QQuickWindow* window )
+        {
+            auto& cache = caches[ window ];
+            if ( cache == nullptr )
+            {
+                cache = new Cache();
+
+                /*
+                    The textures are bound to the scene graph, so we have to
+                    get rid of them, when the scene graph is invalidated.
+                    As the signal is emitted from the scene graph thread, with
+                    the context being current, we need a direct connection.
+                 */
+                cache->connection = QObject::connect(
+                    window, &QQuickWindow::sceneGraphInvalidated,
+                    window, [ this, window ] { removeCache( window ); },
+                    Qt::DirectConnection );
+            }
+
+            return cache;
+        }
+
+        void removeCache( const QQuickWindow* window )
+        {
+            QMutexLocker locker( &mutex );
+
+            if ( auto cache = caches.take( window ) )
+            {
+                QObject::disconnect( cache->connection );
+                delete cache;
+            }
+        }
+
+        QMutex mutex;
+
+      private:
+        QHash< const QQuickWindow*, Cache* > caches;
+    };
+}
+
+Q_GLOBAL_STATIC( Registry, qskRegistry )
+
+void QskTextureCache::setMaximumBytes( qint64 bytes )
+{
+    qskMaximumBytes.storeRelaxed( qMax( bytes, qint64( 0 ) ) );
+}
+
+qint64 QskTextureCache::maximumBytes()
+{
+    return qskMaximumBytes.loadRelaxed();
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics( const QQuickWindow* window )
+{
+    auto registry = qskRegistry;
+
+    QMutexLocker locker( &registry->mutex );
+
+    if ( auto cache = registry->cache( window ) )
+        return cache->statistics;
+
+    return Statistics();
+}
+
+QSGTexture* QskTextureCache::acquire( QQuickWindow* window, const Key& key )
+{
+    if ( !key.isValid() )
+        return nullptr;
+
+    auto registry = qskRegistry;
+
+    QMutexLocker locker( &registry->mutex );
+
+    auto cache = registry->ensureCache( window );
+
+    auto it = cache->entries.find( key );
+    if ( it == cache->entries.end() )
+    {
+        cache->statistics.misses++;
+        return nullptr;
+    }
+
+    cache->statistics.hits++;
+
+    if ( it->refCount++ == 0 )
+    {
+        cache->unused.erase( it->unusedPos );
+        cache->statistics.unusedTextureCount--;
+    }
+
+    return it->texture;
+}
+
+void QskTextureCache::insert( QQuickWindow* window, const Key& key, QSGTexture* texture )
+{
+    if ( !key.isValid() || texture == nullptr )
+        return;
+
+    auto registry = qskRegistry;
+
+    QMutexLocker locker( &registry->mutex );
+
+    auto cache = registry->ensureCache( window );
+
+    Q_ASSERT( !cache->entries.contains( key ) );
+
+    Cache::Entry entry;
+    entry.texture = texture;
+    entry.bytes = qskTextureBytes( key.size );
+    entry.refCount = 1;
+
+    cache->entries.insert( key, entry );
+
+    cache->statistics.textureCount++;
+    cache->statistics.bytes += entry.bytes;
+
+    cache->trim( qskMaximumBytes.loadRelaxed() );
+}
+
+void QskTextureCache::release( const QQuickWindow* window, const Key& key )
+{
+    if ( !key.isValid() )
+        return;
+
+    auto registry = qskRegistry;
+
+    QMutexLocker locker( &registry->mutex );
+
+    auto cache = registry->cache( window );
+    if ( cache == nullptr )
+        return; // the scene graph has already been invalidated
+
+    auto it = cache->entries.find( key );
+    if ( it == cache->entries.end() )
+        return;
+
+    if ( --it->refCount == 0 )
+    {
+        it->unusedPos = cache->unused.insert( cache->unused.end(), key );
+        cache->statistics.unusedTextureCount++;
+
+        cache->trim( qskMaximumBytes.loadRelaxed() );
+    }
+}
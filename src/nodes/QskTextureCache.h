@@ -0,0 +1,95 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qhashfunctions.h>
+#include <qsize.h>
+
+class QSGTexture;
+class QQuickWindow;
+
+/*
+    A cache for textures, that have been rasterized from the same content:
+    f.e the same icon, that is displayed in all rows of a list.
+
+    The cache is bound to the scene graph of a window and the textures are
+    shared between the nodes, that are referring to them. Textures, that are
+    not referenced anymore, are kept until the total size of the cache
+    exceeds maximumBytes() - the least recently used being dropped first.
+
+    The cache has to be accessed from the scene graph thread only, with the
+    exception of the statistics.
+ */
+namespace QskTextureCache
+{
+    class Key
+    {
+      public:
+        inline bool operator==( const Key& other ) const noexcept
+        {
+            return ( hash == other.hash ) && ( size == other.size )
+                && qFuzzyCompare( devicePixelRatio, other.devicePixelRatio );
+        }
+
+        inline bool operator!=( const Key& other ) const noexcept
+        {
+            return !( *this == other );
+        }
+
+        inline bool isValid() const noexcept
+        {
+            return hash != 0;
+        }
+
+        // a hash value of the content, including the type of the node
+        QskHashValue hash = 0;
+
+        QSize size;
+        qreal devicePixelRatio = 1.0;
+    };
+
+    class Statistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        int textureCount = 0;
+        int unusedTextureCount = 0;
+
+        qint64 bytes = 0;
+    };
+
+    // default: 32MB
+    QSK_EXPORT void setMaximumBytes( qint64 );
+    QSK_EXPORT qint64 maximumBytes();
+
+    QSK_EXPORT Statistics statistics( const QQuickWindow* );
+
+    /*
+        acquire and insert add a reference, that has to be
+        removed by release, when the texture is not needed anymore.
+     */
+    QSGTexture* acquire( QQuickWindow*, const Key& );
+    void insert( QQuickWindow*, const Key&, QSGTexture* );
+    void release( const QQuickWindow*, const Key& );
+}
+
+inline QskHashValue qHash(
+    const QskTextureCache::Key& key, QskHashValue seed = 0 ) noexcept
+{
+    auto hash = qHash( key.hash, seed );
+    hash = qHash( key.size.width(), hash );
+    hash = qHash( key.size.height(), hash );
+
+    return hash;
+}
+
+#endif
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskTreeNode.h"
+#include "QskSGNode.h"
 
 static const auto extraFlag =
     static_cast< QSGNode::Flag >( QSGNode::IsVisitableNode << 1 );
@@ -14,6 +15,21 @@ static inline QSGNode* qskCheckedNode( const QSGNode* node, QSGNode::NodeType ty
         ? const_cast< QSGNode* >( node ) : nullptr;
 }
 
+static inline int qskRoleIndex( quint8 role )
+{
+    /*
+        The roles of the skinlets start at 0, while the reserved
+        roles are at the end of the range. To keep the table small
+        we put the reserved roles in front of the others.
+     */
+    constexpr int reservedCount = QskSGNode::NoRole - QskSGNode::FirstReservedRole + 1;
+
+    if ( role >= QskSGNode::FirstReservedRole )
+        return QskSGNode::NoRole - role;
+
+    return reservedCount + role;
+}
+
 QskTreeNode::QskTreeNode()
 {
     setFlag( extraFlag, true );
@@ -45,6 +61,26 @@ bool QskTreeNode::isSubtreeBlocked() const
     return m_isBlocked;
 }
 
+void QskTreeNode::setRoleNode( quint8 role, QSGNode* node )
+{
+    const int index = qskRoleIndex( role );
+
+    if ( index >= m_roleNodes.size() )
+    {
+        if ( node == nullptr )
+            return;
+
+        m_roleNodes.resize( index + 1 ); // filled with nullptr
+    }
+
+    m_roleNodes[ index ] = node;
+}
+
+QSGNode* QskTreeNode::roleNode( quint8 role ) const
+{
+    return m_roleNodes.value( qskRoleIndex( role ), nullptr );
+}
+
 QskTreeNode* qskTreeNodeCast( QSGNode* node )
 {
     return static_cast< QskTreeNode* >(
@@ -8,9 +8,15 @@
 
 #include "QskGlobal.h"
 #include <qsgnode.h>
+#include <qvector.h>
 
 /*
    Used as paintNode in all QskControls ( see QskControl::updateItemPaintNode )
+
+   QskTreeNode maintains a table for finding its children by their
+   node role ( see QskSGNode::nodeRole ) in constant time. The table
+   is updated by the functions of QskSGNode, so children with a role
+   have to be inserted/removed using those.
  */
 class QSK_EXPORT QskTreeNode final : public QSGNode
 {
@@ -21,11 +27,16 @@ class QSK_EXPORT QskTreeNode final : public QSGNode
     void setSubtreeBlocked( bool on, bool notify = true );
     bool isSubtreeBlocked() const override;
 
+    void setRoleNode( quint8 role, QSGNode* );
+    QSGNode* roleNode( quint8 role ) const;
+
   protected:
     QskTreeNode( QSGNodePrivate& );
 
   private:
     bool m_isBlocked = false;;
+
+    QVector< QSGNode* > m_roleNodes;
 };
 
 QSK_EXPORT QskTreeNode* qskTreeNodeCast( QSGNode* );
@@ -80,14 +80,18 @@ namespace QskVertex
         if ( ratio >= 1.0 )
             return colorTo;
 
-        const auto t = ratio;
-        const auto rt = 1.0 - ratio;
+        /*
+            8 bit fixed point arithmetic: this is called for each
+            vertex of a gradient and is easier to vectorize for the compiler
+         */
+        const auto t = static_cast< unsigned int >( ratio * 256.0 );
+        const auto rt = 256u - t;
 
         return Color(
-            static_cast< unsigned char >( rt * r + t * colorTo.r ),
-            static_cast< unsigned char >( rt * g + t * colorTo.g ),
-            static_cast< unsigned char >( rt * b + t * colorTo.b ),
-            static_cast< unsigned char >( rt * a + t * colorTo.a ) 
+            static_cast< unsigned char >( ( rt * r + t * colorTo.r ) >> 8 ),
+            static_cast< unsigned char >( ( rt * g + t * colorTo.g ) >> 8 ),
+            static_cast< unsigned char >( ( rt * b + t * colorTo.b ) >> 8 ),
+            static_cast< unsigned char >( ( rt * a + t * colorTo.a ) >> 8 )
         );
     }
 
@@ -0,0 +1,53 @@
+#version 440
+
+/*
+    coord: xy - position relative to the center of the box, zw - half size
+    radius: bottom-right, top-right, bottom-left, top-left
+    gradient: start point and normalized gradient vector
+    metrics: border width, size of a device pixel, coverage limit
+ */
+layout( location = 0 ) in vec4 coord;
+layout( location = 1 ) in vec4 radius;
+layout( location = 2 ) in vec4 gradient;
+layout( location = 3 ) in vec3 metrics;
+layout( location = 4 ) in vec4 fillColor1;
+layout( location = 5 ) in vec4 fillColor2;
+layout( location = 6 ) in vec4 borderColor;
+
+layout( location = 0 ) out vec4 fragColor;
+
+/*
+    radii: bottom-right, top-right, bottom-left, top-left
+    point: relative to the center of the box
+ */
+float roundedBoxDistance( in vec2 point, in vec2 halfSize, in vec4 radii )
+{
+    vec2 r2 = ( point.x > 0.0 ) ? radii.xy : radii.zw;
+    float r = ( point.y > 0.0 ) ? r2.x : r2.y;
+
+    vec2 q = abs( point ) - halfSize + r;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - r;
+}
+
+void main()
+{
+    float d = roundedBoxDistance( coord.xy, coord.zw, radius );
+
+    float outer = clamp( 0.5 - d / metrics.y, 0.0, 1.0 );
+
+    // opaque boxes are drawn without blending: no antialiasing of the outline
+    if ( metrics.z > 0.0 )
+    {
+        if ( outer < metrics.z )
+            discard;
+
+        outer = 1.0;
+    }
+
+    float inner = clamp( 0.5 - ( d + metrics.x ) / metrics.y, 0.0, 1.0 );
+
+    float t = clamp( dot( coord.xy - gradient.xy, gradient.zw ), 0.0, 1.0 );
+    vec4 fill = mix( fillColor1, fillColor2, t );
+
+    fragColor = fill * inner + borderColor * ( outer - inner );
+}
@@ -0,0 +1,40 @@
+#version 440
+
+layout( location = 0 ) in vec4 in_vertex;
+layout( location = 1 ) in vec4 in_coord;
+layout( location = 2 ) in vec4 in_radius;
+layout( location = 3 ) in vec4 in_gradient;
+layout( location = 4 ) in vec3 in_metrics;
+layout( location = 5 ) in vec4 in_fillColor1;
+layout( location = 6 ) in vec4 in_fillColor2;
+layout( location = 7 ) in vec4 in_borderColor;
+
+layout( location = 0 ) out vec4 coord;
+layout( location = 1 ) out vec4 radius;
+layout( location = 2 ) out vec4 gradient;
+layout( location = 3 ) out vec3 metrics;
+layout( location = 4 ) out vec4 fillColor1;
+layout( location = 5 ) out vec4 fillColor2;
+layout( location = 6 ) out vec4 borderColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    float opacity;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    coord = in_coord;
+    radius = in_radius;
+    gradient = in_gradient;
+    metrics = in_metrics;
+
+    fillColor1 = in_fillColor1 * ubuf.opacity;
+    fillColor2 = in_fillColor2 * ubuf.opacity;
+    borderColor = in_borderColor * ubuf.opacity;
+
+    gl_Position = ubuf.matrix * in_vertex;
+}
@@ -0,0 +1,50 @@
+/*
+    coord: xy - position relative to the center of the box, zw - half size
+    radius: bottom-right, top-right, bottom-left, top-left
+    gradient: start point and normalized gradient vector
+    metrics: border width, size of a device pixel, coverage limit
+ */
+varying highp vec4 coord;
+varying highp vec4 radius;
+varying highp vec4 gradient;
+varying highp vec3 metrics;
+varying lowp vec4 fillColor1;
+varying lowp vec4 fillColor2;
+varying lowp vec4 borderColor;
+
+/*
+    radii: bottom-right, top-right, bottom-left, top-left
+    point: relative to the center of the box
+ */
+highp float roundedBoxDistance( in highp vec2 point,
+    in highp vec2 halfSize, in highp vec4 radii )
+{
+    highp vec2 r2 = ( point.x > 0.0 ) ? radii.xy : radii.zw;
+    highp float r = ( point.y > 0.0 ) ? r2.x : r2.y;
+
+    highp vec2 q = abs( point ) - halfSize + r;
+    return min( max( q.x, q.y ), 0.0 ) + length( max( q, 0.0 ) ) - r;
+}
+
+void main()
+{
+    highp float d = roundedBoxDistance( coord.xy, coord.zw, radius );
+
+    lowp float outer = clamp( 0.5 - d / metrics.y, 0.0, 1.0 );
+
+    // opaque boxes are drawn without blending: no antialiasing of the outline
+    if ( metrics.z > 0.0 )
+    {
+        if ( outer < metrics.z )
+            discard;
+
+        outer = 1.0;
+    }
+
+    lowp float inner = clamp( 0.5 - ( d + metrics.x ) / metrics.y, 0.0, 1.0 );
+
+    lowp float t = clamp( dot( coord.xy - gradient.xy, gradient.zw ), 0.0, 1.0 );
+    lowp vec4 fill = mix( fillColor1, fillColor2, t );
+
+    gl_FragColor = fill * inner + borderColor * ( outer - inner );
+}
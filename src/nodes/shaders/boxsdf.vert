@@ -0,0 +1,33 @@
+uniform highp mat4 matrix;
+uniform lowp float opacity;
+
+attribute highp vec4 in_vertex;
+attribute highp vec4 in_coord;
+attribute highp vec4 in_radius;
+attribute highp vec4 in_gradient;
+attribute highp vec3 in_metrics;
+attribute lowp vec4 in_fillColor1;
+attribute lowp vec4 in_fillColor2;
+attribute lowp vec4 in_borderColor;
+
+varying highp vec4 coord;
+varying highp vec4 radius;
+varying highp vec4 gradient;
+varying highp vec3 metrics;
+varying lowp vec4 fillColor1;
+varying lowp vec4 fillColor2;
+varying lowp vec4 borderColor;
+
+void main()
+{
+    coord = in_coord;
+    radius = in_radius;
+    gradient = in_gradient;
+    metrics = in_metrics;
+
+    fillColor1 = in_fillColor1 * opacity;
+    fillColor2 = in_fillColor2 * opacity;
+    borderColor = in_borderColor * opacity;
+
+    gl_Position = matrix * in_vertex;
+}
@@ -11,6 +11,7 @@ layout( std140, binding = 0 ) uniform buf
     float start;
     float span;
     float opacity;
+    vec2 ramp;
 } ubuf;
 
 out gl_PerVertex { vec4 gl_Position; };
@@ -1,4 +1,5 @@
 uniform sampler2D colorRamp;
+uniform highp vec2 ramp;
 uniform lowp float opacity;
 
 uniform highp float start;
@@ -8,7 +9,16 @@ varying highp vec2 coord;
 
 lowp vec4 colorAt( highp float value )
 {
-    return texture2D( colorRamp, vec2( value, 0.0 ) );
+    // ramp: row of the atlas, spread mode
+
+    if ( ramp.y > 1.5 )
+        value = fract( value ); // RepeatSpread
+    else if ( ramp.y > 0.5 )
+        value = 1.0 - abs( mod( value, 2.0 ) - 1.0 ); // ReflectSpread
+    else
+        value = clamp( value, 0.0, 1.0 ); // PadSpread
+
+    return texture2D( colorRamp, vec2( value, ramp.x ) );
 }
 
 void main()
@@ -8,13 +8,23 @@ layout( std140, binding = 0 ) uniform buf
     mat4 matrix;
     vec4 vector;
     float opacity;
+    vec2 ramp;
 } ubuf;
 
 layout( binding = 1 ) uniform sampler2D colorRamp;
 
 vec4 colorAt( float value )
 {
-    return texture( colorRamp, vec2( value, 0.0 ) );
+    // ramp: row of the atlas, spread mode
+
+    if ( ubuf.ramp.y > 1.5 )
+        value = fract( value ); // RepeatSpread
+    else if ( ubuf.ramp.y > 0.5 )
+        value = 1.0 - abs( mod( value, 2.0 ) - 1.0 ); // ReflectSpread
+    else
+        value = clamp( value, 0.0, 1.0 ); // PadSpread
+
+    return texture( colorRamp, vec2( value, ubuf.ramp.x ) );
 }
 
 void main()
@@ -8,6 +8,7 @@ layout( std140, binding = 0 ) uniform buf
     mat4 matrix;
     vec4 vector;
     float opacity;
+    vec2 ramp;
 } ubuf;
 
 out gl_PerVertex { vec4 gl_Position; };
@@ -9,6 +9,9 @@ function qsbcompile {
 qsbcompile arcshadow-vulkan.vert
 qsbcompile arcshadow-vulkan.frag
 
+qsbcompile boxsdf-vulkan.vert
+qsbcompile boxsdf-vulkan.frag
+
 qsbcompile boxshadow-vulkan.vert
 qsbcompile boxshadow-vulkan.frag
 